@@ -21,7 +21,7 @@ UI_DIR = tmp/moc
 RCC_DIR = tmp/rc
 
 # Project libs
-LIBS *= -lprotobuf -lQt5Core -lGLU
+LIBS *= -lprotobuf -lQt5Core -lGLU -lrt
 
 # Compiling .proto files
 system(echo "Compiling protobuf files" && cd include/proto && protoc --cpp_out=../ *.proto && cd ../..)
@@ -42,12 +42,15 @@ SOURCES += \
         include/vssref_command.pb.cc \
         include/vssref_common.pb.cc \
         include/vssref_placement.pb.cc \
+        include/vssref_worldstate.pb.cc \
         main.cpp \
         src/constants/constants.cpp \
+        src/matchcontext/matchcontext.cpp \
         src/refereecore.cpp \
         src/soccerview/fieldview/fieldview.cpp \
         src/soccerview/fieldview/gltext/gltext.cpp \
         src/soccerview/soccerview.cpp \
+        src/utils/clock/clock.cpp \
         src/utils/types/angle/angle.cpp \
         src/utils/types/field/field.cpp \
         src/utils/types/object/object.cpp \
@@ -55,9 +58,22 @@ SOURCES += \
         src/utils/types/velocity/velocity.cpp \
         src/utils/utils.cpp \
         src/world/entities/entity.cpp \
+        src/world/entities/lockstep/lockstep.cpp \
+        src/world/entities/metricsserver/metricsserver.cpp \
+        src/world/entities/networkreactor/networkreactor.cpp \
+        src/world/entities/statebroadcaster/statebroadcaster.cpp \
+        src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.cpp \
         src/utils/exithandler/exithandler.cpp \
         src/utils/text/text.cpp \
+        src/utils/latency/latencytracker.cpp \
         src/utils/timer/timer.cpp \
+        src/utils/logger/logger.cpp \
+        src/utils/metrics/metrics.cpp \
+        src/utils/shmring/shmring.cpp \
+        src/utils/lockprofiler/lockprofiler.cpp \
+        src/utils/scheduling/scheduling.cpp \
+        src/utils/tracer/tracer.cpp \
+        src/utils/tracedapplication/tracedapplication.cpp \
         src/world/entities/referee/checkers/ballplay/checker_ballplay.cpp \
         src/world/entities/referee/checkers/checker.cpp \
         src/world/entities/referee/checkers/goalie/checker_goalie.cpp \
@@ -66,7 +82,14 @@ SOURCES += \
         src/world/entities/referee/checkers/twoattackers/checker_twoattackers.cpp \
         src/world/entities/referee/checkers/twodefenders/checker_twodefenders.cpp \
         src/world/entities/referee/referee.cpp \
+        src/world/entities/referee/foulqueue/foulqueue.cpp \
+        src/world/entities/referee/settledetector/settledetector.cpp \
+        src/world/entities/referee/commandstream/commandstream.cpp \
         src/world/entities/replacer/replacer.cpp \
+        src/world/entities/replacer/placementbuilder/placementbuilder.cpp \
+        src/world/entities/replacer/placementtemplates/placementtemplates.cpp \
+        src/world/entities/replacer/placementvalidator/placementvalidator.cpp \
+        src/world/entities/simulator/simulator.cpp \
         src/world/entities/vision/filters/loss/lossfilter.cpp \
         src/world/entities/vision/filters/noise/noisefilter.cpp \
         src/world/entities/vision/filters/kalman/kalmanfilter.cpp \
@@ -88,11 +111,14 @@ HEADERS += \
     include/vssref_command.pb.h \
     include/vssref_common.pb.h \
     include/vssref_placement.pb.h \
+    include/vssref_worldstate.pb.h \
     src/constants/constants.h \
+    src/matchcontext/matchcontext.h \
     src/refereecore.h \
     src/soccerview/fieldview/fieldview.h \
     src/soccerview/fieldview/gltext/gltext.h \
     src/soccerview/soccerview.h \
+    src/utils/clock/clock.h \
     src/utils/types/angle/angle.h \
     src/utils/types/field/field.h \
     src/utils/types/field/field_default_3v3.h \
@@ -101,9 +127,23 @@ HEADERS += \
     src/utils/types/velocity/velocity.h \
     src/utils/utils.h \
     src/world/entities/entity.h \
+    src/world/entities/lockstep/lockstep.h \
+    src/world/entities/metricsserver/metricsserver.h \
+    src/world/entities/networkreactor/networkreactor.h \
+    src/world/entities/statebroadcaster/statebroadcaster.h \
+    src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.h \
     src/utils/exithandler/exithandler.h \
     src/utils/text/text.h \
+    src/utils/latency/latencytracker.h \
     src/utils/timer/timer.h \
+    src/utils/logger/logger.h \
+    src/utils/metrics/metrics.h \
+    src/utils/shmring/shmring.h \
+    src/utils/lockprofiler/lockprofiler.h \
+    src/utils/scheduling/scheduling.h \
+    src/utils/spscqueue/spscqueue.h \
+    src/utils/tracer/tracer.h \
+    src/utils/tracedapplication/tracedapplication.h \
     src/world/entities/referee/checkers/ballplay/checker_ballplay.h \
     src/world/entities/referee/checkers/checker.h \
     src/world/entities/referee/checkers/checkers.h \
@@ -113,13 +153,22 @@ HEADERS += \
     src/world/entities/referee/checkers/twoattackers/checker_twoattackers.h \
     src/world/entities/referee/checkers/twodefenders/checker_twodefenders.h \
     src/world/entities/referee/referee.h \
+    src/world/entities/referee/foulqueue/foulqueue.h \
+    src/world/entities/referee/settledetector/settledetector.h \
+    src/world/entities/referee/commandstream/commandstream.h \
     src/world/entities/replacer/replacer.h \
+    src/world/entities/replacer/replacercommand/replacercommand.h \
+    src/world/entities/replacer/placementbuilder/placementbuilder.h \
+    src/world/entities/replacer/placementtemplates/placementtemplates.h \
+    src/world/entities/replacer/placementvalidator/placementvalidator.h \
+    src/world/entities/simulator/simulator.h \
     src/world/entities/vision/filters/loss/lossfilter.h \
     src/world/entities/vision/filters/noise/noisefilter.h \
     src/world/entities/vision/filters/kalman/kalmanfilter.h \
     src/world/entities/vision/filters/kalman/matrix/matrix.h \
     src/world/entities/vision/filters/kalman/state/kalmanstate.h \
     src/world/entities/vision/vision.h \
+    src/world/entities/vision/visionsnapshot/visionsnapshot.h \
     src/world/world.h
 
 FORMS += \
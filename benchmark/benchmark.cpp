@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <QFile>
+#include <QTextStream>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#include <src/utils/text/text.h>
+
+namespace {
+    std::atomic<quint64> allocationsCount(0);
+}
+
+// Counting global allocations
+void* operator new(std::size_t size) {
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if(ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+Benchmark::Benchmark() {
+    _minTime = 0.5;
+    _repetitions = 5;
+}
+
+quint64 Benchmark::allocations() {
+    return allocationsCount.load(std::memory_order_relaxed);
+}
+
+void Benchmark::addCase(QString name, std::function<void()> operation) {
+    _cases.push_back({name, operation});
+}
+
+void Benchmark::setFilter(QString filter) {
+    _filter = filter;
+}
+
+void Benchmark::setMinTime(double seconds) {
+    _minTime = seconds;
+}
+
+void Benchmark::setRepetitions(int repetitions) {
+    _repetitions = std::max(1, repetitions);
+}
+
+void Benchmark::run() {
+    _results.clear();
+
+    for(int i = 0; i < _cases.size(); i++) {
+        const Case &benchmarkCase = _cases.at(i);
+        if(!_filter.isEmpty() && !benchmarkCase.name.contains(_filter)) {
+            continue;
+        }
+
+        Result result = runCase(benchmarkCase);
+        _results.push_back(result);
+
+        std::cout << Text::blue("[BENCHMARK] ", true) + Text::bold(result.name.toStdString() + ": " + std::to_string(result.nsPerOp) + " ns/op, " + std::to_string(result.allocsPerOp) + " allocs/op (" + std::to_string(result.iterations) + " iterations)") + '\n';
+    }
+}
+
+Benchmark::Result Benchmark::runCase(const Case &benchmarkCase) {
+    // Warm up
+    for(int i = 0; i < 10; i++) {
+        benchmarkCase.operation();
+    }
+
+    // Calibrate iterations (each repetition takes about minTime / repetitions)
+    const double repetitionTime = _minTime / _repetitions;
+    quint64 iterations = 1;
+    double elapsed = measure(benchmarkCase, iterations);
+    while(elapsed < repetitionTime / 10.0 && iterations < (1ULL << 40)) {
+        iterations *= 10;
+        elapsed = measure(benchmarkCase, iterations);
+    }
+    iterations = std::max<quint64>(1, static_cast<quint64>(iterations * (repetitionTime / std::max(elapsed, 1E-9))));
+
+    // Take median of repetitions
+    QVector<double> nsPerOp;
+    quint64 allocationsBefore = allocations();
+    for(int i = 0; i < _repetitions; i++) {
+        nsPerOp.push_back(measure(benchmarkCase, iterations) * 1E9 / iterations);
+    }
+    quint64 allocationsAfter = allocations();
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    Result result;
+    result.name = benchmarkCase.name;
+    result.iterations = iterations;
+    result.nsPerOp = nsPerOp.at(nsPerOp.size() / 2);
+    result.allocsPerOp = double(allocationsAfter - allocationsBefore) / (double(iterations) * _repetitions);
+
+    return result;
+}
+
+double Benchmark::measure(const Case &benchmarkCase, quint64 iterations) {
+    Timer timer;
+    timer.start();
+    for(quint64 i = 0; i < iterations; i++) {
+        benchmarkCase.operation();
+    }
+    timer.stop();
+
+    return timer.getSeconds();
+}
+
+void Benchmark::printReport() {
+    std::cout << Text::blue("[BENCHMARK] ", true) + Text::bold("name | ns/op | allocs/op | iterations") + '\n';
+    for(int i = 0; i < _results.size(); i++) {
+        const Result &result = _results.at(i);
+        std::cout << Text::blue("[BENCHMARK] ", true) + result.name.toStdString() + " | " + std::to_string(result.nsPerOp) + " | " + std::to_string(result.allocsPerOp) + " | " + std::to_string(result.iterations) + '\n';
+    }
+}
+
+bool Benchmark::writeJson(QString fileName) {
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::cout << Text::blue("[BENCHMARK] ", true) << Text::red("Error while opening '" + fileName.toStdString() + "'.", true) + '\n';
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "{\n  \"version\": \"" << APP_VERSION << "\",\n  \"benchmarks\": [\n";
+    for(int i = 0; i < _results.size(); i++) {
+        const Result &result = _results.at(i);
+        stream << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp << ", \"allocs_per_op\": " << result.allocsPerOp << "}" << ((i + 1 < _results.size()) ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+
+    file.close();
+
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include <src/utils/timer/timer.h>
+
+class Benchmark
+{
+public:
+    Benchmark();
+
+    // Cases management
+    void addCase(QString name, std::function<void()> operation);
+
+    // Setters
+    void setFilter(QString filter);
+    void setMinTime(double seconds);
+    void setRepetitions(int repetitions);
+
+    // Run and report
+    void run();
+    void printReport();
+    bool writeJson(QString fileName);
+
+    // Keep values alive (avoid compiler removing benchmarked code)
+    template<typename T>
+    static void keep(const T &value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    // Allocation counter (global operator new)
+    static quint64 allocations();
+
+private:
+    // Cases
+    struct Case {
+        QString name;
+        std::function<void()> operation;
+    };
+    QVector<Case> _cases;
+
+    // Results
+    struct Result {
+        QString name;
+        quint64 iterations;
+        double nsPerOp;
+        double allocsPerOp;
+    };
+    QVector<Result> _results;
+
+    // Run params
+    QString _filter;
+    double _minTime;
+    int _repetitions;
+
+    // Case execution
+    Result runCase(const Case &benchmarkCase);
+    double measure(const Case &benchmarkCase, quint64 iterations);
+};
+
+#endif // BENCHMARK_H
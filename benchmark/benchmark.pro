@@ -0,0 +1,169 @@
+# Qt libs to import
+QT += core    \
+      gui     \
+      widgets \
+      network \
+      opengl
+
+# Referee sources are included from the repository root
+ROOT_PATH = $${PWD}/..
+INCLUDEPATH += $${ROOT_PATH}
+
+# Project configs
+TEMPLATE = app
+DESTDIR  = $${ROOT_PATH}/bin
+TARGET   = VSSBenchmark
+VERSION  = 2.0.0
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+# Temporary dirs
+OBJECTS_DIR = tmp/obj
+MOC_DIR = tmp/moc
+UI_DIR = tmp/moc
+RCC_DIR = tmp/rc
+
+# Project libs
+LIBS *= -lprotobuf -lQt5Core -lGLU -lrt
+
+# Compiling .proto files
+system(echo "Compiling protobuf files" && cd $${ROOT_PATH}/include/proto && protoc --cpp_out=../ *.proto)
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += APP_VERSION=\\\"$$VERSION\\\"
+DEFINES += PROJECT_PATH=\\\"$${ROOT_PATH}\\\"
+
+SOURCES += \
+        $${ROOT_PATH}/include/command.pb.cc \
+        $${ROOT_PATH}/include/common.pb.cc \
+        $${ROOT_PATH}/include/packet.pb.cc \
+        $${ROOT_PATH}/include/replacement.pb.cc \
+        $${ROOT_PATH}/include/vssref_command.pb.cc \
+        $${ROOT_PATH}/include/vssref_common.pb.cc \
+        $${ROOT_PATH}/include/vssref_placement.pb.cc \
+        $${ROOT_PATH}/include/vssref_worldstate.pb.cc \
+        $${ROOT_PATH}/src/constants/constants.cpp \
+        $${ROOT_PATH}/src/soccerview/fieldview/fieldview.cpp \
+        $${ROOT_PATH}/src/soccerview/fieldview/gltext/gltext.cpp \
+        $${ROOT_PATH}/src/soccerview/soccerview.cpp \
+        $${ROOT_PATH}/src/utils/clock/clock.cpp \
+        $${ROOT_PATH}/src/utils/types/angle/angle.cpp \
+        $${ROOT_PATH}/src/utils/types/field/field.cpp \
+        $${ROOT_PATH}/src/utils/types/object/object.cpp \
+        $${ROOT_PATH}/src/utils/types/position/position.cpp \
+        $${ROOT_PATH}/src/utils/types/velocity/velocity.cpp \
+        $${ROOT_PATH}/src/utils/utils.cpp \
+        $${ROOT_PATH}/src/world/entities/entity.cpp \
+        $${ROOT_PATH}/src/world/entities/lockstep/lockstep.cpp \
+        $${ROOT_PATH}/src/utils/exithandler/exithandler.cpp \
+        $${ROOT_PATH}/src/utils/text/text.cpp \
+        $${ROOT_PATH}/src/utils/latency/latencytracker.cpp \
+        $${ROOT_PATH}/src/utils/timer/timer.cpp \
+        $${ROOT_PATH}/src/utils/logger/logger.cpp \
+        $${ROOT_PATH}/src/utils/metrics/metrics.cpp \
+        $${ROOT_PATH}/src/utils/shmring/shmring.cpp \
+        $${ROOT_PATH}/src/utils/lockprofiler/lockprofiler.cpp \
+        $${ROOT_PATH}/src/utils/scheduling/scheduling.cpp \
+        $${ROOT_PATH}/src/utils/tracer/tracer.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/ballplay/checker_ballplay.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/checker.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/goalie/checker_goalie.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/halftime/checker_halftime.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/stoppedball/checker_stuckedball.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/twoattackers/checker_twoattackers.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/checkers/twodefenders/checker_twodefenders.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/referee.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/foulqueue/foulqueue.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/settledetector/settledetector.cpp \
+        $${ROOT_PATH}/src/world/entities/networkreactor/networkreactor.cpp \
+        $${ROOT_PATH}/src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.cpp \
+        $${ROOT_PATH}/src/world/entities/referee/commandstream/commandstream.cpp \
+        $${ROOT_PATH}/src/world/entities/replacer/replacer.cpp \
+        $${ROOT_PATH}/src/world/entities/replacer/placementbuilder/placementbuilder.cpp \
+        $${ROOT_PATH}/src/world/entities/replacer/placementtemplates/placementtemplates.cpp \
+        $${ROOT_PATH}/src/world/entities/replacer/placementvalidator/placementvalidator.cpp \
+        $${ROOT_PATH}/src/world/entities/simulator/simulator.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/filters/loss/lossfilter.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/filters/noise/noisefilter.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/filters/kalman/kalmanfilter.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/filters/kalman/matrix/matrix.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/filters/kalman/state/kalmanstate.cpp \
+        $${ROOT_PATH}/src/world/entities/vision/vision.cpp \
+        $${ROOT_PATH}/src/world/world.cpp \
+        benchmark.cpp \
+        cases.cpp \
+        fixture.cpp \
+        main.cpp
+
+HEADERS += \
+    $${ROOT_PATH}/include/command.pb.h \
+    $${ROOT_PATH}/include/common.pb.h \
+    $${ROOT_PATH}/include/packet.pb.h \
+    $${ROOT_PATH}/include/replacement.pb.h \
+    $${ROOT_PATH}/include/vssref_command.pb.h \
+    $${ROOT_PATH}/include/vssref_common.pb.h \
+    $${ROOT_PATH}/include/vssref_placement.pb.h \
+    $${ROOT_PATH}/include/vssref_worldstate.pb.h \
+    $${ROOT_PATH}/src/constants/constants.h \
+    $${ROOT_PATH}/src/soccerview/fieldview/fieldview.h \
+    $${ROOT_PATH}/src/soccerview/fieldview/gltext/gltext.h \
+    $${ROOT_PATH}/src/soccerview/soccerview.h \
+    $${ROOT_PATH}/src/utils/clock/clock.h \
+    $${ROOT_PATH}/src/utils/types/angle/angle.h \
+    $${ROOT_PATH}/src/utils/types/field/field.h \
+    $${ROOT_PATH}/src/utils/types/field/field_default_3v3.h \
+    $${ROOT_PATH}/src/utils/types/object/object.h \
+    $${ROOT_PATH}/src/utils/types/position/position.h \
+    $${ROOT_PATH}/src/utils/types/velocity/velocity.h \
+    $${ROOT_PATH}/src/utils/utils.h \
+    $${ROOT_PATH}/src/world/entities/entity.h \
+    $${ROOT_PATH}/src/world/entities/lockstep/lockstep.h \
+    $${ROOT_PATH}/src/utils/exithandler/exithandler.h \
+    $${ROOT_PATH}/src/utils/text/text.h \
+    $${ROOT_PATH}/src/utils/latency/latencytracker.h \
+    $${ROOT_PATH}/src/utils/timer/timer.h \
+    $${ROOT_PATH}/src/utils/logger/logger.h \
+    $${ROOT_PATH}/src/utils/metrics/metrics.h \
+    $${ROOT_PATH}/src/utils/shmring/shmring.h \
+    $${ROOT_PATH}/src/utils/lockprofiler/lockprofiler.h \
+    $${ROOT_PATH}/src/utils/scheduling/scheduling.h \
+    $${ROOT_PATH}/src/utils/spscqueue/spscqueue.h \
+    $${ROOT_PATH}/src/utils/tracer/tracer.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/ballplay/checker_ballplay.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/checker.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/checkers.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/goalie/checker_goalie.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/halftime/checker_halftime.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/stoppedball/checker_stuckedball.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/twoattackers/checker_twoattackers.h \
+    $${ROOT_PATH}/src/world/entities/referee/checkers/twodefenders/checker_twodefenders.h \
+    $${ROOT_PATH}/src/world/entities/referee/referee.h \
+    $${ROOT_PATH}/src/world/entities/referee/foulqueue/foulqueue.h \
+    $${ROOT_PATH}/src/world/entities/referee/settledetector/settledetector.h \
+    $${ROOT_PATH}/src/world/entities/networkreactor/networkreactor.h \
+    $${ROOT_PATH}/src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.h \
+    $${ROOT_PATH}/src/world/entities/referee/commandstream/commandstream.h \
+    $${ROOT_PATH}/src/world/entities/replacer/replacer.h \
+    $${ROOT_PATH}/src/world/entities/replacer/replacercommand/replacercommand.h \
+    $${ROOT_PATH}/src/world/entities/replacer/placementbuilder/placementbuilder.h \
+    $${ROOT_PATH}/src/world/entities/replacer/placementtemplates/placementtemplates.h \
+    $${ROOT_PATH}/src/world/entities/replacer/placementvalidator/placementvalidator.h \
+    $${ROOT_PATH}/src/world/entities/simulator/simulator.h \
+    $${ROOT_PATH}/src/world/entities/vision/filters/loss/lossfilter.h \
+    $${ROOT_PATH}/src/world/entities/vision/filters/noise/noisefilter.h \
+    $${ROOT_PATH}/src/world/entities/vision/filters/kalman/kalmanfilter.h \
+    $${ROOT_PATH}/src/world/entities/vision/filters/kalman/matrix/matrix.h \
+    $${ROOT_PATH}/src/world/entities/vision/filters/kalman/state/kalmanstate.h \
+    $${ROOT_PATH}/src/world/entities/vision/vision.h \
+    $${ROOT_PATH}/src/world/entities/vision/visionsnapshot/visionsnapshot.h \
+    $${ROOT_PATH}/src/world/world.h \
+    benchmark.h \
+    cases.h \
+    fixture.h
+
+FORMS += \
+    $${ROOT_PATH}/src/soccerview/soccerview.ui
+
+RESOURCES += \
+    $${ROOT_PATH}/rsc/resources.qrc
@@ -0,0 +1,264 @@
+#include <benchmark/cases.h>
+
+#include <memory>
+#include <unistd.h>
+
+#include <src/utils/utils.h>
+#include <src/utils/types/object/object.h>
+#include <src/world/entities/vision/filters/kalman/kalmanfilter.h>
+#include <src/world/entities/vision/filters/kalman/matrix/matrix.h>
+#include <src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.h>
+#include <src/utils/shmring/shmring.h>
+
+void BenchmarkCases::addUtilsCases(Benchmark *benchmark, BenchmarkFixture *fixture) {
+    Constants *constants = fixture->getConstants();
+    const Position a(true, -0.3f, 0.2f);
+    const Position b(true, 0.4f, -0.1f);
+    const Position point(true, 0.1f, 0.35f);
+    const Position areaPoint(true, -0.68f, 0.05f);
+
+    benchmark->addCase("utils/distance", [a, b]() {
+        float distance = Utils::distance(a, b);
+        Benchmark::keep(distance);
+    });
+
+    benchmark->addCase("utils/isInsideGoalArea", [areaPoint, constants]() {
+        bool isInside = Utils::isInsideGoalArea(VSSRef::Color::BLUE, areaPoint, constants);
+        Benchmark::keep(isInside);
+    });
+
+    benchmark->addCase("utils/isBallInsideGoal", [areaPoint, constants]() {
+        bool isInside = Utils::isBallInsideGoal(VSSRef::Color::BLUE, areaPoint, constants);
+        Benchmark::keep(isInside);
+    });
+
+    benchmark->addCase("utils/projectPointAtSegment", [a, b, point]() {
+        Position projection = Utils::projectPointAtSegment(a, b, point);
+        Benchmark::keep(projection);
+    });
+
+    benchmark->addCase("utils/distanceToSegment", [a, b, point]() {
+        float distance = Utils::distanceToSegment(a, b, point);
+        Benchmark::keep(distance);
+    });
+
+    benchmark->addCase("utils/getBallQuadrant", [point]() {
+        VSSRef::Quadrant quadrant = Utils::getBallQuadrant(point);
+        Benchmark::keep(quadrant);
+    });
+}
+
+void BenchmarkCases::addMatrixCases(Benchmark *benchmark) {
+    // Kalman uses 3x3 models
+    std::shared_ptr<Matrix> A = std::make_shared<Matrix>(Matrix::identity(3));
+    std::shared_ptr<Matrix> B = std::make_shared<Matrix>(Matrix::diag(3, 2.0f));
+    A->set(0, 1, 0.016f);
+    A->set(0, 2, 0.000128f);
+    A->set(1, 2, 0.016f);
+
+    benchmark->addCase("matrix/multiply3x3", [A, B]() {
+        Matrix C = (*A) * (*B);
+        Benchmark::keep(C);
+    });
+
+    benchmark->addCase("matrix/add3x3", [A, B]() {
+        Matrix C = (*A) + (*B);
+        Benchmark::keep(C);
+    });
+
+    benchmark->addCase("matrix/transposed3x3", [A]() {
+        Matrix C = A->transposed();
+        Benchmark::keep(C);
+    });
+
+    benchmark->addCase("matrix/covarianceUpdate3x3", [A, B]() {
+        Matrix P = (*A) * (*B) * A->transposed() + (*B);
+        Benchmark::keep(P);
+    });
+}
+
+void BenchmarkCases::addFilterCases(Benchmark *benchmark) {
+    std::shared_ptr<KalmanFilter> iterateFilter = std::make_shared<KalmanFilter>();
+    std::shared_ptr<KalmanFilter> predictFilter = std::make_shared<KalmanFilter>();
+    predictFilter->iterate(Position(true, 0.0f, 0.0f));
+    predictFilter->iterate(Position(true, 0.01f, 0.0f));
+
+    benchmark->addCase("kalman/iterate", [iterateFilter]() {
+        iterateFilter->iterate(Position(true, 0.1f, 0.2f));
+        Benchmark::keep(*iterateFilter);
+    });
+
+    benchmark->addCase("kalman/predict", [predictFilter]() {
+        predictFilter->predict();
+        Benchmark::keep(*predictFilter);
+    });
+
+    // Objects with and without Kalman (valid positions)
+    std::shared_ptr<Object> object = std::make_shared<Object>(false, 0, 300);
+    std::shared_ptr<Object> kalmanObject = std::make_shared<Object>(true, 0, 300);
+
+    benchmark->addCase("object/updateObject", [object]() {
+        object->updateObject(1.0f, Position(true, 0.1f, 0.2f), Angle(true, 0.5f));
+        Benchmark::keep(*object);
+    });
+
+    benchmark->addCase("object/updateObjectKalman", [kalmanObject]() {
+        kalmanObject->updateObject(1.0f, Position(true, 0.1f, 0.2f), Angle(true, 0.5f));
+        Benchmark::keep(*kalmanObject);
+    });
+}
+
+void BenchmarkCases::addVisionCases(Benchmark *benchmark, BenchmarkFixture *fixture) {
+    Vision *vision = fixture->getVision();
+    const fira_message::sim_to_ref::Environment *environment = &fixture->getEnvironment();
+    const std::string *environmentData = &fixture->getEnvironmentData();
+
+    benchmark->addCase("vision/parseEnvironment", [environmentData]() {
+        fira_message::sim_to_ref::Environment environmentParsed;
+        bool parsed = environmentParsed.ParseFromArray(environmentData->data(), environmentData->size());
+        Benchmark::keep(parsed);
+    });
+
+    benchmark->addCase("vision/processEnvironment", [vision, environment]() {
+        vision->processEnvironment(*environment);
+    });
+
+    benchmark->addCase("vision/decodeFrame", [vision, environmentData]() {
+        fira_message::sim_to_ref::Environment environmentParsed;
+        if(environmentParsed.ParseFromArray(environmentData->data(), environmentData->size())) {
+            vision->processEnvironment(environmentParsed);
+        }
+    });
+
+    benchmark->addCase("vision/getAvailablePlayers", [vision]() {
+        QList<quint8> players = vision->getAvailablePlayers(VSSRef::Color::BLUE);
+        Benchmark::keep(players);
+    });
+
+    // Filtered state broadcast (snapshot and delta encoding, as sent at each frame)
+    std::shared_ptr<WorldStateEncoder> encoder = std::make_shared<WorldStateEncoder>();
+    std::shared_ptr<VisionSnapshot> snapshot = std::make_shared<VisionSnapshot>();
+    std::shared_ptr<std::string> datagram = std::make_shared<std::string>();
+    benchmark->addCase("vision/encodeWorldState", [vision, encoder, snapshot, datagram]() {
+        vision->takeSnapshot(snapshot.get());
+        snapshot->frameCount++;
+        encoder->encode(*snapshot, 0.0, datagram.get());
+        Benchmark::keep(*datagram);
+    });
+
+    // Shared memory transport (simulator serializes into the slot, vision parses from it)
+    std::string ringName = "/vssreferee_benchmark_" + std::to_string(getpid());
+    std::shared_ptr<ShmRing> producerRing = std::make_shared<ShmRing>();
+    std::shared_ptr<ShmRing> consumerRing = std::make_shared<ShmRing>();
+    if(producerRing->create(ringName, ShmRing::PAYLOAD_ENVIRONMENT, 64, 8192) && consumerRing->attach(ringName, ShmRing::PAYLOAD_ENVIRONMENT)) {
+        benchmark->addCase("vision/ringFrame", [producerRing, consumerRing, environment]() {
+            size_t environmentSize = environment->ByteSizeLong();
+            environment->SerializeWithCachedSizesToArray(reinterpret_cast<quint8*>(producerRing->beginWrite()));
+            producerRing->endWrite(environmentSize);
+
+            quint32 size = 0;
+            fira_message::sim_to_ref::Environment environmentParsed;
+            const char *data = consumerRing->peek(&size);
+            bool parsed = (data != nullptr && environmentParsed.ParseFromArray(data, size) && consumerRing->commit());
+            Benchmark::keep(parsed);
+        });
+    }
+}
+
+void BenchmarkCases::addCheckerCases(Benchmark *benchmark, BenchmarkFixture *fixture) {
+    QList<Checker*> checkers = fixture->getCheckers();
+
+    for(int i = 0; i < checkers.size(); i++) {
+        Checker *checker = checkers.at(i);
+        benchmark->addCase("checker/" + checker->name() + "/run", [checker]() {
+            checker->run();
+        });
+    }
+
+    // Foul dispatch, from the checker report to the referee taking it
+    std::shared_ptr<FoulQueue> foulQueue = std::make_shared<FoulQueue>();
+    Checker *checker = checkers.first();
+    benchmark->addCase("checker/foulQueue/dispatch", [foulQueue, checker]() {
+        FoulEvent foulEvent;
+        foulQueue->push({checker, VSSRef::Foul::FREE_KICK, VSSRef::Color::BLUE, VSSRef::Quadrant::QUADRANT_1});
+        foulQueue->pop(&foulEvent);
+        Benchmark::keep(foulEvent);
+    });
+}
+
+void BenchmarkCases::addReplacerCases(Benchmark *benchmark, BenchmarkFixture *fixture) {
+    Replacer *replacer = fixture->getReplacer();
+
+    // Frame placement goes through placeFrame, packet is serialized as sent to network
+    benchmark->addCase("replacer/placeFrame", [replacer]() {
+        replacer->placeOutside(VSSRef::Foul::KICKOFF, VSSRef::Color::YELLOW);
+        std::string msg;
+        replacer->takePendingPacket().SerializeToString(&msg);
+        Benchmark::keep(msg);
+    });
+
+    // Both teams and ball, built in one packet
+    benchmark->addCase("replacer/placeTeams", [replacer]() {
+        replacer->placeTeams();
+        std::string msg;
+        replacer->takePendingPacket().SerializeToString(&msg);
+        Benchmark::keep(msg);
+    });
+
+    // Halt frame saved from one vision snapshot and replayed
+    benchmark->addCase("replacer/saveAndPlaceLastFrame", [replacer]() {
+        replacer->saveFrameAndBall();
+        replacer->placeLastFrameAndBall();
+        std::string msg;
+        replacer->takePendingPacket().SerializeToString(&msg);
+        Benchmark::keep(msg);
+    });
+
+    benchmark->addCase("replacer/placeBall", [replacer]() {
+        replacer->placeBall(Position(true, 0.0f, 0.0f));
+        std::string msg;
+        replacer->takePendingPacket().SerializeToString(&msg);
+        Benchmark::keep(msg);
+    });
+}
+
+bool BenchmarkCases::checkReplacerCases(BenchmarkFixture *fixture) {
+    Replacer *replacer = fixture->getReplacer();
+
+    // Placement of a team, as sent to the replacer socket
+    VSSRef::team_to_ref::VSSRef_Placement placement;
+    placement.mutable_world()->set_teamcolor(VSSRef::Color::BLUE);
+    VSSRef::Robot *robot = placement.mutable_world()->add_robots();
+    robot->set_robot_id(0);
+    robot->set_x(-0.2);
+    robot->set_y(0.0);
+    robot->set_orientation(0.0);
+    std::string datagram;
+    placement.SerializeToString(&datagram);
+
+    // Last foul is placed
+    replacer->placeTeams();
+    replacer->takePendingPacket();
+
+    // New foul is queued and the team answers in the batch read before the replacer loop drains it
+    ReplacerCommand command;
+    command.type = ReplacerCommand::TAKE_FOUL;
+    command.foul = VSSRef::Foul::FREE_KICK;
+    command.teamColor = VSSRef::Color::BLUE;
+    command.quadrant = VSSRef::Quadrant::NO_QUADRANT;
+    replacer->pushCommand(command);
+    replacer->takePlacementDatagram(datagram.data(), static_cast<int>(datagram.size()));
+    bool isTaken = (replacer->takeLatePlacements() == 1);
+
+    // Clear state for the cases
+    ReplacerAck ack;
+    while(replacer->takeAck(&ack));
+    replacer->placeTeams();
+    replacer->takePendingPacket();
+
+    if(!isTaken) {
+        std::cout << Text::blue("[BENCHMARK] ", true) << Text::red("Placement received in the same loop as its foul was dropped.", true) + '\n';
+    }
+
+    return isTaken;
+}
@@ -0,0 +1,19 @@
+#ifndef CASES_H
+#define CASES_H
+
+#include <benchmark/benchmark.h>
+#include <benchmark/fixture.h>
+
+namespace BenchmarkCases {
+    void addUtilsCases(Benchmark *benchmark, BenchmarkFixture *fixture);
+    void addMatrixCases(Benchmark *benchmark);
+    void addFilterCases(Benchmark *benchmark);
+    void addVisionCases(Benchmark *benchmark, BenchmarkFixture *fixture);
+    void addCheckerCases(Benchmark *benchmark, BenchmarkFixture *fixture);
+    void addReplacerCases(Benchmark *benchmark, BenchmarkFixture *fixture);
+
+    // Behavior checks of the benchmarked paths (run once, before the cases)
+    bool checkReplacerCases(BenchmarkFixture *fixture);
+}
+
+#endif // CASES_H
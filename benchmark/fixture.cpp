@@ -0,0 +1,128 @@
+#include <benchmark/fixture.h>
+
+BenchmarkFixture::BenchmarkFixture(QString constantsFileName) {
+    // Loading constants
+    _constants = new Constants(constantsFileName);
+
+    // Stepped clock, so filters and checkers timers are deterministic
+    _clock = new Clock();
+    _clock->setStepped(true);
+
+    // Creating modules (threads are never started)
+    _vision = new Vision(getConstants(), getClock());
+    _replacer = new Replacer(_vision, getConstants(), getClock());
+    _replacer->setLockstep(true);
+    _referee = new Referee(_vision, _replacer, nullptr, getConstants(), getClock());
+
+    // Feed snapshot (twice, so objects pass through noise filter)
+    buildSnapshot();
+    _vision->processEnvironment(_environment);
+    _clock->advance(1.0);
+    _vision->processEnvironment(_environment);
+
+    // Creating checkers
+    createCheckers();
+}
+
+BenchmarkFixture::~BenchmarkFixture() {
+    for(int i = 0; i < _checkers.size(); i++) {
+        delete _checkers.at(i);
+    }
+    delete _referee;
+    delete _replacer;
+    delete _vision;
+    delete _clock;
+    delete _constants;
+}
+
+void BenchmarkFixture::buildSnapshot() {
+    // Defending team is at left side
+    bool blueIsLeft = getConstants()->blueIsLeftSide();
+    float factor = (blueIsLeft) ? -1.0 : 1.0;
+
+    _environment.set_step(1);
+    fira_message::Frame *frame = _environment.mutable_frame();
+
+    // Ball inside defending team goal area (a play is running)
+    fira_message::Ball *ball = frame->mutable_ball();
+    ball->set_x(factor * 0.68);
+    ball->set_y(0.05);
+
+    // Two defenders inside goal area and one at midfield
+    const float defenders[3][2] = {{0.70f, 0.10f}, {0.70f, -0.10f}, {0.30f, 0.00f}};
+
+    // Two attackers close to the ball and one at the other side
+    const float attackers[3][2] = {{0.60f, 0.15f}, {0.60f, -0.15f}, {-0.30f, 0.00f}};
+
+    for(int i = 0; i < getConstants()->qtPlayers(); i++) {
+        fira_message::Robot *defender = (blueIsLeft) ? frame->add_robots_blue() : frame->add_robots_yellow();
+        defender->set_robot_id(i);
+        defender->set_x(factor * defenders[i % 3][0]);
+        defender->set_y(defenders[i % 3][1] + 0.05 * (i / 3));
+        defender->set_orientation(0.0);
+
+        fira_message::Robot *attacker = (blueIsLeft) ? frame->add_robots_yellow() : frame->add_robots_blue();
+        attacker->set_robot_id(i);
+        attacker->set_x(factor * attackers[i % 3][0]);
+        attacker->set_y(attackers[i % 3][1] + 0.05 * (i / 3));
+        attacker->set_orientation(M_PI);
+    }
+
+    _environment.SerializeToString(&_environmentData);
+}
+
+void BenchmarkFixture::createCheckers() {
+    Checker_StuckedBall *stuckedBall = new Checker_StuckedBall(_vision, getConstants(), getClock());
+    stuckedBall->setIsPenaltyShootout(false, VSSRef::Color::NONE);
+
+    Checker_TwoAttackers *twoAttackers = new Checker_TwoAttackers(_vision, getConstants(), getClock());
+    Checker_TwoDefenders *twoDefenders = new Checker_TwoDefenders(_vision, getConstants(), getClock());
+
+    Checker_BallPlay *ballPlay = new Checker_BallPlay(_vision, getConstants(), getClock());
+    ballPlay->setAtkDefCheckers(twoAttackers, twoDefenders);
+    ballPlay->setIsPenaltyShootout(false, VSSRef::Color::NONE);
+
+    Checker_Goalie *goalie = new Checker_Goalie(_vision, getConstants(), getClock());
+
+    Checker_HalfTime *halfTime = new Checker_HalfTime(_vision, getConstants(), getClock());
+    halfTime->setReferee(_referee);
+    halfTime->setIsOvertime(false);
+    halfTime->setIsPenaltyShootout(false);
+
+    _checkers << stuckedBall << twoAttackers << twoDefenders << ballPlay << goalie << halfTime;
+    for(int i = 0; i < _checkers.size(); i++) {
+        _checkers.at(i)->configure();
+    }
+}
+
+Constants* BenchmarkFixture::getConstants() {
+    return _constants;
+}
+
+Clock* BenchmarkFixture::getClock() {
+    return _clock;
+}
+
+QList<Checker*> BenchmarkFixture::getCheckers() {
+    return _checkers;
+}
+
+Vision* BenchmarkFixture::getVision() {
+    return _vision;
+}
+
+Replacer* BenchmarkFixture::getReplacer() {
+    return _replacer;
+}
+
+Referee* BenchmarkFixture::getReferee() {
+    return _referee;
+}
+
+const fira_message::sim_to_ref::Environment& BenchmarkFixture::getEnvironment() {
+    return _environment;
+}
+
+const std::string& BenchmarkFixture::getEnvironmentData() {
+    return _environmentData;
+}
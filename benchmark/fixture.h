@@ -0,0 +1,45 @@
+#ifndef FIXTURE_H
+#define FIXTURE_H
+
+#include <src/constants/constants.h>
+#include <src/utils/clock/clock.h>
+#include <src/world/entities/vision/vision.h>
+#include <src/world/entities/replacer/replacer.h>
+#include <src/world/entities/referee/referee.h>
+#include <src/world/entities/referee/checkers/checkers.h>
+
+class BenchmarkFixture
+{
+public:
+    BenchmarkFixture(QString constantsFileName);
+    ~BenchmarkFixture();
+
+    // Getters
+    Constants* getConstants();
+    Clock* getClock();
+    Vision* getVision();
+    Replacer* getReplacer();
+    Referee* getReferee();
+    QList<Checker*> getCheckers();
+    const fira_message::sim_to_ref::Environment& getEnvironment();
+    const std::string& getEnvironmentData();
+
+private:
+    // Modules (not started, used directly)
+    Constants *_constants;
+    Clock *_clock;
+    Vision *_vision;
+    Replacer *_replacer;
+    Referee *_referee;
+
+    // Checkers (configured as in referee)
+    QList<Checker*> _checkers;
+    void createCheckers();
+
+    // Canned snapshot
+    fira_message::sim_to_ref::Environment _environment;
+    std::string _environmentData;
+    void buildSnapshot();
+};
+
+#endif // FIXTURE_H
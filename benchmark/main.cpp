@@ -0,0 +1,62 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <benchmark/benchmark.h>
+#include <benchmark/fixture.h>
+#include <benchmark/cases.h>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationVersion(APP_VERSION);
+
+    // Parsing command line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("VSSReferee microbenchmarks");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("constants", "Constants file used by the benchmarked modules.", "[constants]");
+    parser.addOption(QCommandLineOption("filter", "Only run cases whose name contains the filter.", "filter"));
+    parser.addOption(QCommandLineOption("min-time", "Minimum measured time for each case (s).", "seconds", "0.5"));
+    parser.addOption(QCommandLineOption("repetitions", "Repetitions for each case (median is reported).", "repetitions", "5"));
+    parser.addOption(QCommandLineOption("json", "Write results as json to file.", "file"));
+    parser.process(app);
+
+    QString constantsFile = QString(PROJECT_PATH) + "/src/constants/constants.json";
+    if(!parser.positionalArguments().isEmpty()) {
+        constantsFile = parser.positionalArguments().first();
+    }
+
+    // Canned snapshot and modules
+    BenchmarkFixture *fixture = new BenchmarkFixture(constantsFile);
+
+    // Registering cases
+    Benchmark *benchmark = new Benchmark();
+    benchmark->setFilter(parser.value("filter"));
+    benchmark->setMinTime(parser.value("min-time").toDouble());
+    benchmark->setRepetitions(parser.value("repetitions").toInt());
+
+    BenchmarkCases::addUtilsCases(benchmark, fixture);
+    BenchmarkCases::addMatrixCases(benchmark);
+    BenchmarkCases::addFilterCases(benchmark);
+    BenchmarkCases::addVisionCases(benchmark, fixture);
+    BenchmarkCases::addCheckerCases(benchmark, fixture);
+    BenchmarkCases::addReplacerCases(benchmark, fixture);
+
+    // Behavior checks
+    bool checked = BenchmarkCases::checkReplacerCases(fixture);
+
+    // Run and report
+    benchmark->run();
+    benchmark->printReport();
+
+    bool written = true;
+    if(parser.isSet("json")) {
+        written = benchmark->writeJson(parser.value("json"));
+    }
+
+    delete benchmark;
+    delete fixture;
+
+    return (written && checked) ? 0 : 1;
+}
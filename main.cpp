@@ -1,9 +1,15 @@
+#include <QCommandLineParser>
+
 #include <src/utils/exithandler/exithandler.h>
+#include <src/utils/tracedapplication/tracedapplication.h>
+#include <src/utils/tracer/tracer.h>
+#include <src/utils/logger/logger.h>
+#include <src/utils/lockprofiler/lockprofiler.h>
 #include <src/refereecore.h>
 
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
+    TracedApplication app(argc, argv);
     app.setApplicationVersion(APP_VERSION);
 
     // Showing banner
@@ -18,22 +24,65 @@ int main(int argc, char *argv[])
     ExitHandler::setApplication(&app);
     ExitHandler::setup();
 
-    // Initializing constants
-    Constants *constants = new Constants(QString(PROJECT_PATH) + "/src/constants/constants.json");
+    // Parsing command line (one constants file per match)
+    QCommandLineParser parser;
+    parser.setApplicationDescription("VSSReferee");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("constants", "Constants files, one for each match hosted by this process.", "[constants...]");
+    parser.addOption(QCommandLineOption("trace", "Write a chrome trace (chrome://tracing, Perfetto) of the entities to file.", "file"));
+    parser.addOption(QCommandLineOption("log-level", "Minimum level of logged records (debug, info, warning or error).", "level", "info"));
+    parser.addOption(QCommandLineOption("log-file", "Also write records (one json per line) to file.", "file"));
+    parser.addOption(QCommandLineOption("log-rate", "Maximum records per second of each log call site (0 disables the limit).", "records", "10"));
+    parser.addOption(QCommandLineOption("no-terminal-log", "Do not write records to terminal."));
+    parser.addOption(QCommandLineOption("lock-stats", "Record wait and hold times of the shared locks, reported at exit."));
+    parser.process(app);
+
+    // Starting logger
+    bool isValidLevel;
+    Logger::Level logLevel = Logger::levelFromName(parser.value("log-level"), &isValidLevel);
+    if(!isValidLevel) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Invalid log level '" + parser.value("log-level").toStdString() + "', using 'info'.") + '\n';
+    }
+    Logger::startLogger(logLevel, !parser.isSet("no-terminal-log"), parser.value("log-file"), parser.value("log-rate").toInt());
+
+    // Starting tracer (if requested)
+    if(parser.isSet("trace")) {
+        Tracer::startTracing(parser.value("trace"));
+        Tracer::setThreadName("GUI");
+    }
 
-    // Initializating referee core
-    RefereeCore *refereeCore = new RefereeCore(constants);
+    // Starting lock profiling (if requested)
+    if(parser.isSet("lock-stats")) {
+        LockProfiler::startProfiling();
+        LockProfiler::setThreadName("GUI");
+    }
+
+    QStringList constantsFiles = parser.positionalArguments();
+    if(constantsFiles.isEmpty()) {
+        constantsFiles.push_back(QString(PROJECT_PATH) + "/src/constants/constants.json");
+    }
+
+    // Initializating referee core with its matches
+    RefereeCore *refereeCore = new RefereeCore();
+    for(int i = 0; i < constantsFiles.size(); i++) {
+        refereeCore->addMatch(constantsFiles.at(i));
+    }
     refereeCore->start();
 
     // Wait for app exec
     bool exec = app.exec();
 
-    // Stopping and deleting referee core
+    // Stopping and deleting referee core (and its matches)
     refereeCore->stop();
     delete refereeCore;
 
-    // Deleting constants
-    delete constants;
+    // Report lock contention (if profiled)
+    LockProfiler::printReport();
+
+    // Flushing trace and logs
+    Tracer::stopTracing();
+    Logger::stopLogger();
 
     return exec;
 }
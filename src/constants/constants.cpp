@@ -1,8 +1,5 @@
 #include "constants.h"
 
-#include <src/world/entities/vision/filters/loss/lossfilter.h>
-#include <src/world/entities/vision/filters/noise/noisefilter.h>
-
 Constants::Constants(QString fileName) {
     // Taking fileName
     _fileName = fileName;
@@ -22,6 +19,12 @@ Constants::Constants(QString fileName) {
     readRefereeConstants();
     readVisionConstants();
     readReplacerConstants();
+    readSimulatorConstants();
+    readLockstepConstants();
+    readLatencyConstants();
+    readMetricsConstants();
+    readBroadcastConstants();
+    readSharedMemoryConstants();
     readTeamConstants();
 }
 
@@ -32,6 +35,25 @@ void Constants::readEntityConstants() {
     // Filling vars
     _threadFrequency = threadMap["threadFrequency"].toInt();
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded threadFrequency: " + std::to_string(_threadFrequency)) + '\n';
+
+    _idleTime = threadMap["idleTime"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded idleTime: " + std::to_string(_idleTime)) + '\n';
+
+    _lockMemory = threadMap["lockMemory"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded lockMemory: " + std::to_string(_lockMemory)) + '\n';
+
+    // Without it sockets are polled at each entity loop frequency
+    _useNetworkReactor = threadMap.value("useNetworkReactor", false).toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useNetworkReactor: " + std::to_string(_useNetworkReactor)) + '\n';
+
+    // Scheduling of each entity (by entity name)
+    QVariantMap schedulingMap = threadMap["scheduling"].toMap();
+    QList<QString> entitiesNames = schedulingMap.keys();
+    for(int i = 0; i < entitiesNames.size(); i++) {
+        Scheduling scheduling(schedulingMap[entitiesNames.at(i)].toMap());
+        _entitiesScheduling.insert(entitiesNames.at(i), scheduling);
+        std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded " + entitiesNames.at(i).toStdString() + " scheduling: " + scheduling.toString()) + '\n';
+    }
 }
 
 void Constants::readRefereeConstants() {
@@ -88,6 +110,35 @@ void Constants::readRefereeConstants() {
     _maintainSpeedAtSuggestions = foulsMap["maintainSpeedAtSuggestions"].toBool();
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded maintainSpeedAtSuggestions: '" + std::to_string(_maintainSpeedAtSuggestions) + "'\n");
 
+    // Transition settle
+    // Taking settle mapping in json
+    QVariantMap settleMap = refereeMap["settle"].toMap();
+
+    // Filling vars
+    // Without it transitions always wait the fixed transitionTime
+    _useSettleDetection = settleMap.value("useSettleDetection", false).toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useSettleDetection: '" + std::to_string(_useSettleDetection) + "'\n");
+
+    _settleFrames = settleMap["settleFrames"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded settleFrames: '" + std::to_string(_settleFrames) + "'\n");
+
+    _settlePositionTolerance = settleMap["settlePositionTolerance"].toFloat();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded settlePositionTolerance: '" + std::to_string(_settlePositionTolerance) + "'\n");
+
+    _settleSpeedThreshold = settleMap["settleSpeedThreshold"].toFloat();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded settleSpeedThreshold: '" + std::to_string(_settleSpeedThreshold) + "'\n");
+
+    // Command heartbeat
+    // Taking heartbeat mapping in json
+    QVariantMap heartbeatMap = refereeMap["heartbeat"].toMap();
+
+    // Filling vars
+    // Without it each command is written once (sequence and send timestamp are still set)
+    _useCommandHeartbeat = heartbeatMap.value("useCommandHeartbeat", false).toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useCommandHeartbeat: '" + std::to_string(_useCommandHeartbeat) + "'\n");
+
+    _heartbeatFrequency = heartbeatMap["heartbeatFrequency"].toFloat();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded heartbeatFrequency: '" + std::to_string(_heartbeatFrequency) + "'\n");
 }
 
 void Constants::readVisionConstants() {
@@ -108,11 +159,9 @@ void Constants::readVisionConstants() {
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useKalman: " + std::to_string(_useKalman)) + '\n';
 
     _noiseTime = filterMap["noiseTime"].toInt();
-    NoiseFilter::setNoiseTime(_noiseTime);
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded noiseTime: " + std::to_string(_noiseTime)) + '\n';
 
     _lossTime = filterMap["lossTime"].toInt();
-    LossFilter::setLossTime(_lossTime);
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded lossTime: " + std::to_string(_lossTime)) + '\n';
 
 }
@@ -134,6 +183,114 @@ void Constants::readReplacerConstants() {
     _firaPort = replacerMap["firaPort"].toUInt();
     std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded firaPort: " + std::to_string(_firaPort)) + '\n';
 
+    // Without it team placements are sent as the teams built them
+    _usePlacementValidation = replacerMap.value("usePlacementValidation", false).toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded usePlacementValidation: " + std::to_string(_usePlacementValidation)) + '\n';
+
+    _placementValidationBudget = replacerMap["placementValidationBudget"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded placementValidationBudget: " + std::to_string(_placementValidationBudget)) + '\n';
+}
+
+void Constants::readSimulatorConstants() {
+    // Taking simulator mapping in json
+    QVariantMap simulatorMap = documentMap()["Simulator"].toMap();
+
+    // Filling vars
+    _useSimulator = simulatorMap["useSimulator"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useSimulator: " + std::to_string(_useSimulator)) + '\n';
+
+    _simulatorFrequency = simulatorMap["simulatorFrequency"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded simulatorFrequency: " + std::to_string(_simulatorFrequency)) + '\n';
+}
+
+void Constants::readLockstepConstants() {
+    // Taking lockstep mapping in json
+    QVariantMap lockstepMap = documentMap()["Lockstep"].toMap();
+
+    // Filling vars
+    _useLockstep = lockstepMap["useLockstep"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useLockstep: " + std::to_string(_useLockstep)) + '\n';
+
+    _stepTime = lockstepMap["stepTime"].toFloat();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded stepTime: '" + std::to_string(_stepTime) + "'\n");
+
+    _simulatorAddress = lockstepMap["simulatorAddress"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded simulatorAddress: '" + _simulatorAddress.toStdString() + "'\n");
+
+    _simulatorPort = lockstepMap["simulatorPort"].toUInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded simulatorPort: " + std::to_string(_simulatorPort)) + '\n';
+}
+
+void Constants::readLatencyConstants() {
+    // Taking latency mapping in json
+    QVariantMap latencyMap = documentMap()["Latency"].toMap();
+
+    // Filling vars
+    _useLatencyTracing = latencyMap["useLatencyTracing"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useLatencyTracing: " + std::to_string(_useLatencyTracing)) + '\n';
+
+    _slowDecisionTime = latencyMap["slowDecisionTime"].toFloat();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded slowDecisionTime: '" + std::to_string(_slowDecisionTime) + "'\n");
+
+    _latencyReportFile = latencyMap["latencyReportFile"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded latencyReportFile: '" + _latencyReportFile.toStdString() + "'\n");
+}
+
+void Constants::readMetricsConstants() {
+    // Taking metrics mapping in json
+    QVariantMap metricsMap = documentMap()["Metrics"].toMap();
+
+    // Filling vars
+    _useMetrics = metricsMap["useMetrics"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useMetrics: " + std::to_string(_useMetrics)) + '\n';
+
+    _metricsAddress = metricsMap["metricsAddress"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded metricsAddress: '" + _metricsAddress.toStdString() + "'\n");
+
+    _metricsPort = metricsMap["metricsPort"].toUInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded metricsPort: " + std::to_string(_metricsPort)) + '\n';
+}
+
+void Constants::readBroadcastConstants() {
+    // Taking broadcast mapping in json
+    QVariantMap broadcastMap = documentMap()["Broadcast"].toMap();
+
+    // Filling vars
+    _useStateBroadcast = broadcastMap["useStateBroadcast"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useStateBroadcast: " + std::to_string(_useStateBroadcast)) + '\n';
+
+    _broadcastAddress = broadcastMap["broadcastAddress"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded broadcastAddress: '" + _broadcastAddress.toStdString() + "'\n");
+
+    _broadcastPort = broadcastMap["broadcastPort"].toUInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded broadcastPort: " + std::to_string(_broadcastPort)) + '\n';
+
+    _keyFrameInterval = broadcastMap["keyFrameInterval"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded keyFrameInterval: " + std::to_string(_keyFrameInterval)) + '\n';
+}
+
+void Constants::readSharedMemoryConstants() {
+    // Taking shared memory mapping in json
+    QVariantMap sharedMemoryMap = documentMap()["SharedMemory"].toMap();
+
+    // Filling vars
+    _useSharedMemory = sharedMemoryMap["useSharedMemory"].toBool();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded useSharedMemory: " + std::to_string(_useSharedMemory)) + '\n';
+
+    _visionRing = sharedMemoryMap["visionRing"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded visionRing: '" + _visionRing.toStdString() + "'\n");
+
+    _commandRing = sharedMemoryMap["commandRing"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded commandRing: '" + _commandRing.toStdString() + "'\n");
+
+    _stateRing = sharedMemoryMap["stateRing"].toString();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded stateRing: '" + _stateRing.toStdString() + "'\n");
+
+    _ringSlots = sharedMemoryMap["ringSlots"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded ringSlots: " + std::to_string(_ringSlots)) + '\n';
+
+    _ringSlotSize = sharedMemoryMap["ringSlotSize"].toInt();
+    std::cout << Text::purple("[CONSTANTS] ", true) << Text::bold("Loaded ringSlotSize: " + std::to_string(_ringSlotSize)) + '\n';
 }
 
 void Constants::readTeamConstants() {
@@ -158,6 +315,22 @@ int Constants::threadFrequency() {
     return _threadFrequency;
 }
 
+int Constants::idleTime() {
+    return _idleTime;
+}
+
+bool Constants::lockMemory() {
+    return _lockMemory;
+}
+
+bool Constants::useNetworkReactor() {
+    return _useNetworkReactor;
+}
+
+Scheduling Constants::entityScheduling(QString entityName) {
+    return _entitiesScheduling.value(entityName, Scheduling());
+}
+
 QString Constants::refereeAddress() {
     return _refereeAddress;
 }
@@ -210,6 +383,30 @@ bool Constants::maintainSpeedAtSuggestions() {
     return _maintainSpeedAtSuggestions;
 }
 
+bool Constants::useSettleDetection() {
+    return _useSettleDetection;
+}
+
+int Constants::settleFrames() {
+    return _settleFrames;
+}
+
+float Constants::settlePositionTolerance() {
+    return _settlePositionTolerance;
+}
+
+float Constants::settleSpeedThreshold() {
+    return _settleSpeedThreshold;
+}
+
+bool Constants::useCommandHeartbeat() {
+    return (_useCommandHeartbeat && _heartbeatFrequency > 0.0f);
+}
+
+float Constants::heartbeatFrequency() {
+    return _heartbeatFrequency;
+}
+
 QString Constants::visionAddress() {
     return _visionAddress;
 }
@@ -246,6 +443,102 @@ quint16 Constants::firaPort() {
     return _firaPort;
 }
 
+bool Constants::usePlacementValidation() {
+    return _usePlacementValidation;
+}
+
+int Constants::placementValidationBudget() {
+    return _placementValidationBudget;
+}
+
+bool Constants::useSimulator() {
+    return _useSimulator;
+}
+
+int Constants::simulatorFrequency() {
+    return _simulatorFrequency;
+}
+
+bool Constants::useLockstep() {
+    return _useLockstep;
+}
+
+float Constants::stepTime() {
+    return _stepTime;
+}
+
+QString Constants::simulatorAddress() {
+    return _simulatorAddress;
+}
+
+quint16 Constants::simulatorPort() {
+    return _simulatorPort;
+}
+
+bool Constants::useLatencyTracing() {
+    return _useLatencyTracing;
+}
+
+float Constants::slowDecisionTime() {
+    return _slowDecisionTime;
+}
+
+QString Constants::latencyReportFile() {
+    return _latencyReportFile;
+}
+
+bool Constants::useMetrics() {
+    return _useMetrics;
+}
+
+QString Constants::metricsAddress() {
+    return _metricsAddress;
+}
+
+quint16 Constants::metricsPort() {
+    return _metricsPort;
+}
+
+bool Constants::useStateBroadcast() {
+    return _useStateBroadcast;
+}
+
+QString Constants::broadcastAddress() {
+    return _broadcastAddress;
+}
+
+quint16 Constants::broadcastPort() {
+    return _broadcastPort;
+}
+
+int Constants::keyFrameInterval() {
+    return _keyFrameInterval;
+}
+
+bool Constants::useSharedMemory() {
+    return _useSharedMemory;
+}
+
+QString Constants::visionRing() {
+    return _visionRing;
+}
+
+QString Constants::commandRing() {
+    return _commandRing;
+}
+
+QString Constants::stateRing() {
+    return _stateRing;
+}
+
+int Constants::ringSlots() {
+    return _ringSlots;
+}
+
+int Constants::ringSlotSize() {
+    return _ringSlotSize;
+}
+
 int Constants::qtPlayers() {
     return _qtPlayers;
 }
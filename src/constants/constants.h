@@ -4,10 +4,12 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QVariantMap>
+#include <QHash>
 #include <QString>
 #include <QFile>
 
 #include <src/utils/text/text.h>
+#include <src/utils/scheduling/scheduling.h>
 
 class Constants
 {
@@ -16,6 +18,10 @@ public:
 
     // Entities constants getters
     int threadFrequency();
+    int idleTime();
+    bool lockMemory();
+    bool useNetworkReactor();
+    Scheduling entityScheduling(QString entityName);
 
     // Referee constants getters
     QString refereeAddress();
@@ -31,6 +37,12 @@ public:
     float ballInAreaMaxTime();
     bool useRefereeSuggestions();
     bool maintainSpeedAtSuggestions();
+    bool useSettleDetection();
+    int settleFrames();
+    float settlePositionTolerance();
+    float settleSpeedThreshold();
+    bool useCommandHeartbeat();
+    float heartbeatFrequency();
 
     // Vision constants getters
     QString visionAddress();
@@ -44,6 +56,42 @@ public:
     quint16 replacerPort();
     QString firaAddress();
     quint16 firaPort();
+    bool usePlacementValidation();
+    int placementValidationBudget();
+
+    // Simulator constants getters
+    bool useSimulator();
+    int simulatorFrequency();
+
+    // Lockstep constants getters
+    bool useLockstep();
+    float stepTime();
+    QString simulatorAddress();
+    quint16 simulatorPort();
+
+    // Latency constants getters
+    bool useLatencyTracing();
+    float slowDecisionTime();
+    QString latencyReportFile();
+
+    // Metrics constants getters
+    bool useMetrics();
+    QString metricsAddress();
+    quint16 metricsPort();
+
+    // Broadcast constants getters
+    bool useStateBroadcast();
+    QString broadcastAddress();
+    quint16 broadcastPort();
+    int keyFrameInterval();
+
+    // Shared memory constants getters
+    bool useSharedMemory();
+    QString visionRing();
+    QString commandRing();
+    QString stateRing();
+    int ringSlots();
+    int ringSlotSize();
 
     // Teams constants getters
     int qtPlayers();
@@ -67,6 +115,10 @@ private:
 
     // Entities constants
     int _threadFrequency;
+    int _idleTime;
+    bool _lockMemory;
+    bool _useNetworkReactor;
+    QHash<QString, Scheduling> _entitiesScheduling;
     void readEntityConstants();
 
     // Referee
@@ -83,6 +135,12 @@ private:
     float _ballInAreaMaxTime;
     bool _useRefereeSuggestions;
     bool _maintainSpeedAtSuggestions;
+    bool _useSettleDetection;
+    int _settleFrames;
+    float _settlePositionTolerance;
+    float _settleSpeedThreshold;
+    bool _useCommandHeartbeat;
+    float _heartbeatFrequency;
     void readRefereeConstants();
 
     // Vision constants
@@ -98,8 +156,50 @@ private:
     quint16 _replacerPort;
     QString _firaAddress;
     quint16 _firaPort;
+    bool _usePlacementValidation;
+    int _placementValidationBudget;
     void readReplacerConstants();
 
+    // Simulator constants
+    bool _useSimulator;
+    int _simulatorFrequency;
+    void readSimulatorConstants();
+
+    // Lockstep constants
+    bool _useLockstep;
+    float _stepTime;
+    QString _simulatorAddress;
+    quint16 _simulatorPort;
+    void readLockstepConstants();
+
+    // Latency constants
+    bool _useLatencyTracing;
+    float _slowDecisionTime;
+    QString _latencyReportFile;
+    void readLatencyConstants();
+
+    // Metrics constants
+    bool _useMetrics;
+    QString _metricsAddress;
+    quint16 _metricsPort;
+    void readMetricsConstants();
+
+    // Broadcast constants
+    bool _useStateBroadcast;
+    QString _broadcastAddress;
+    quint16 _broadcastPort;
+    int _keyFrameInterval;
+    void readBroadcastConstants();
+
+    // Shared memory constants
+    bool _useSharedMemory;
+    QString _visionRing;
+    QString _commandRing;
+    QString _stateRing;
+    int _ringSlots;
+    int _ringSlotSize;
+    void readSharedMemoryConstants();
+
     // Teams constants
     int _qtPlayers;
     QString _blueTeamName;
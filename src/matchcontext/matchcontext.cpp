@@ -0,0 +1,188 @@
+#include "matchcontext.h"
+
+MatchContext::MatchContext(int matchId, QString constantsFileName) {
+    // Taking match id
+    _matchId = matchId;
+
+    // Loading match constants
+    _constants = new Constants(constantsFileName);
+
+    // Creating match clock
+    _clock = new Clock();
+
+    // Creating latency tracker (if enabled)
+    _latencyTracker = (getConstants()->useLatencyTracing()) ? new LatencyTracker(getConstants()) : nullptr;
+
+    // Creating runtime metrics (if enabled)
+    _metrics = (getConstants()->useMetrics()) ? new Metrics(_matchId) : nullptr;
+
+    // Creating world pointer
+    _world = new World(getConstants());
+
+    // Modules are created at start
+    _vision = nullptr;
+    _referee = nullptr;
+    _replacer = nullptr;
+    _simulator = nullptr;
+    _lockstep = nullptr;
+    _metricsServer = nullptr;
+    _stateBroadcaster = nullptr;
+    _networkReactor = nullptr;
+    _soccerView = nullptr;
+}
+
+MatchContext::~MatchContext() {
+    // Deleting world module
+    delete _world;
+
+    // Deleting locally stepped simulator (not owned by world)
+    if(_simulator != nullptr && getConstants()->useLockstep()) {
+        delete _simulator;
+    }
+
+    // Deleting GUI
+    delete _soccerView;
+
+    // Deleting latency tracker
+    delete _latencyTracker;
+
+    // Deleting metrics (after entities that update it)
+    delete _metrics;
+
+    // Deleting clock
+    delete _clock;
+
+    // Deleting constants
+    delete _constants;
+}
+
+void MatchContext::start() {
+    // Creating bundled simulator (if enabled)
+    if(getConstants()->useSimulator()) {
+        _simulator = new Simulator(getConstants(), getClock());
+        _simulator->setMetrics(_metrics);
+
+        // Free running simulator is added to world with priority 3 (in lockstep it is stepped locally)
+        if(!getConstants()->useLockstep()) {
+            _world->addEntity(_simulator, 3);
+        }
+    }
+
+    // Creating vision pointer and adding it to world with priority 2
+    _vision = new Vision(getConstants(), getClock());
+    _world->addEntity(_vision, 2);
+
+    _vision->setLatencyTracker(_latencyTracker);
+    _vision->setMetrics(_metrics);
+
+    // Creating GUI
+    _soccerView = new SoccerView(getConstants());
+    _soccerView->setWindowTitle(_soccerView->windowTitle() + " - Match " + QString::number(_matchId));
+
+    // Setting Vision and Constants to FieldView
+    _soccerView->getFieldView()->setVisionModule(_vision);
+    _soccerView->getFieldView()->setConstants(getConstants());
+
+    // Creating replacer pointer
+    _replacer = new Replacer(_vision, getConstants(), getClock());
+    _replacer->setMetrics(_metrics);
+
+    // Creating referee pointer and adding it to world with priority 1
+    _referee = new Referee(_vision, _replacer, _soccerView, getConstants(), getClock());
+    _referee->setLatencyTracker(_latencyTracker);
+    _referee->setMetrics(_metrics);
+    _vision->addFrameListener(_referee);
+    _world->addEntity(_referee, 1);
+
+    // Adding replacer to world with prio 0
+    _world->addEntity(_replacer, 0);
+
+    // Creating state broadcaster (if enabled) and adding it to world with prio 0 (sends each vision frame)
+    if(getConstants()->useStateBroadcast() || getConstants()->useSharedMemory()) {
+        _stateBroadcaster = new StateBroadcaster(_vision, getConstants(), getClock());
+        _stateBroadcaster->setMetrics(_metrics);
+        _vision->addFrameListener(_stateBroadcaster);
+        _world->addEntity(_stateBroadcaster, 0);
+    }
+
+    // In lockstep, referee and replacer run once per simulation step, fed with the simulated frames
+    if(getConstants()->useLockstep()) {
+        _clock->setStepped(true);
+        _vision->disableLoop();
+        _referee->setStepped(true);
+        _replacer->setStepped(true);
+        _replacer->setLockstep(true);
+
+        // Creating lockstep pointer and adding it to world with prio -1 (stopped first)
+        _lockstep = new Lockstep(_vision, _referee, _replacer, (getConstants()->useSimulator()) ? _simulator : nullptr, getConstants(), getClock());
+        _lockstep->setMetrics(_metrics);
+        _world->addEntity(_lockstep, -1);
+    }
+
+    // Creating network reactor and adding it to world with prio 4 (sockets are removed by their owners before it stops)
+    if(getConstants()->useNetworkReactor()) {
+        _networkReactor = new NetworkReactor(getConstants(), getClock());
+        _networkReactor->setMetrics(_metrics);
+        _vision->setNetworkReactor(_networkReactor);
+        _replacer->setNetworkReactor(_networkReactor);
+        _world->addEntity(_networkReactor, 4);
+    }
+
+    // Creating metrics server and adding it to world with prio 4 (started first, stopped last)
+    if(_metrics != nullptr) {
+        _metricsServer = new MetricsServer(_metrics, getConstants(), getClock());
+        _world->addEntity(_metricsServer, 4);
+    }
+
+    // Make GUI connections with modules
+    QObject::connect(_referee, SIGNAL(sendFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)), _soccerView, SLOT(takeFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)));
+    QObject::connect(_referee, SIGNAL(sendTimestamp(float, float, VSSRef::Half, bool)), _soccerView, SLOT(takeTimeStamp(float, float, VSSRef::Half, bool)));
+    QObject::connect(_soccerView, SIGNAL(sendManualFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant, bool)), _referee, SLOT(takeManualFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant, bool)));
+    QObject::connect(_vision, SIGNAL(visionUpdated()), _soccerView->getFieldView(), SLOT(updateField()));
+
+    // Show GUI
+    _soccerView->show();
+
+    // Locking memory (avoids page faults at the entities loops)
+    if(getConstants()->lockMemory()) {
+        Scheduling::lockMemory();
+    }
+
+    // Reset match clock and start entities
+    _clock->reset();
+    _world->startEntities();
+
+    std::cout << Text::cyan("[MATCH] ", true) + Text::bold("Match " + std::to_string(_matchId) + " started (vision: " + std::to_string(getConstants()->visionPort()) + ", referee: " + std::to_string(getConstants()->refereePort()) + ", replacer: " + std::to_string(getConstants()->replacerPort()) + ", fira: " + std::to_string(getConstants()->firaPort()) + ").") + '\n';
+}
+
+void MatchContext::stop() {
+    // Stopping and deleting entities
+    _world->stopAndDeleteEntities();
+
+    // Report decision latencies
+    if(_latencyTracker != nullptr) {
+        _latencyTracker->printReport();
+        if(!getConstants()->latencyReportFile().isEmpty()) {
+            _latencyTracker->exportReport(getConstants()->latencyReportFile());
+        }
+    }
+}
+
+int MatchContext::matchId() {
+    return _matchId;
+}
+
+Constants* MatchContext::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at MatchContext") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
+
+Clock* MatchContext::getClock() {
+    return _clock;
+}
@@ -0,0 +1,65 @@
+#ifndef MATCHCONTEXT_H
+#define MATCHCONTEXT_H
+
+#include <src/utils/utils.h>
+#include <src/utils/clock/clock.h>
+#include <src/utils/latency/latencytracker.h>
+#include <src/utils/metrics/metrics.h>
+#include <src/soccerview/soccerview.h>
+#include <src/world/world.h>
+#include <src/world/entities/vision/vision.h>
+#include <src/world/entities/referee/referee.h>
+#include <src/world/entities/replacer/replacer.h>
+#include <src/world/entities/simulator/simulator.h>
+#include <src/world/entities/lockstep/lockstep.h>
+#include <src/world/entities/metricsserver/metricsserver.h>
+#include <src/world/entities/statebroadcaster/statebroadcaster.h>
+#include <src/world/entities/networkreactor/networkreactor.h>
+
+class MatchContext
+{
+public:
+    MatchContext(int matchId, QString constantsFileName);
+    ~MatchContext();
+
+    // Internal
+    void start();
+    void stop();
+
+    // Getters
+    int matchId();
+    Constants* getConstants();
+    Clock* getClock();
+
+private:
+    // Match info
+    int _matchId;
+
+    // Modules
+    World *_world;
+    Vision *_vision;
+    Referee *_referee;
+    Replacer *_replacer;
+    Simulator *_simulator;
+    Lockstep *_lockstep;
+    MetricsServer *_metricsServer;
+    StateBroadcaster *_stateBroadcaster;
+    NetworkReactor *_networkReactor;
+
+    // GUI
+    SoccerView *_soccerView;
+
+    // Match clock
+    Clock *_clock;
+
+    // Latency tracing (nullptr if disabled)
+    LatencyTracker *_latencyTracker;
+
+    // Runtime metrics (nullptr if disabled)
+    Metrics *_metrics;
+
+    // Constants
+    Constants *_constants;
+};
+
+#endif // MATCHCONTEXT_H
@@ -1,12 +1,6 @@
 #include "refereecore.h"
 
-RefereeCore::RefereeCore(Constants *constants) {
-    // Taking constants
-    _constants = constants;
-
-    // Creating world pointer
-    _world = new World(getConstants());
-
+RefereeCore::RefereeCore() {
     // Register Referee metatypes
     qRegisterMetaType<VSSRef::Color>("VSSRef::Color");
     qRegisterMetaType<VSSRef::Foul>("VSSRef::Foul");
@@ -17,63 +11,67 @@ RefereeCore::RefereeCore(Constants *constants) {
 }
 
 RefereeCore::~RefereeCore() {
-    // Deleting world module
-    delete _world;
+    // Deleting matches
+    for(int i = 0; i < _matches.size(); i++) {
+        delete _matches.at(i);
+    }
 
-    // Deleting GUI
-    delete _soccerView;
+    _matches.clear();
 }
 
-void RefereeCore::start() {
-    // Setup utils
-    Utils::setConstants(getConstants());
+void RefereeCore::addMatch(QString constantsFileName) {
+    // Creating match (id is its index)
+    MatchContext *match = new MatchContext(_matches.size(), constantsFileName);
 
-    // Creating vision pointer and adding it to world with priority 2
-    _vision = new Vision(getConstants());
-    _world->addEntity(_vision, 2);
+    // Check if it can share the process with the other matches
+    if(hasPortConflict(match)) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Match loaded from '" + constantsFileName.toStdString() + "' uses ports from another match, ignoring it.") + '\n';
+        delete match;
+        return ;
+    }
 
-    // Creating GUI
-    _soccerView = new SoccerView(getConstants());
+    _matches.push_back(match);
+}
 
-    // Setting Vision and Constants to FieldView
-    _soccerView->getFieldView()->setVisionModule(_vision);
-    _soccerView->getFieldView()->setConstants(_constants);
+void RefereeCore::start() {
+    // Starting all matches
+    for(int i = 0; i < _matches.size(); i++) {
+        _matches.at(i)->start();
+    }
+}
 
-    // Creating replacer pointer
-    _replacer = new Replacer(_vision, getConstants());
+void RefereeCore::stop() {
+    // Stopping all matches
+    for(int i = 0; i < _matches.size(); i++) {
+        _matches.at(i)->stop();
+    }
+}
 
-    // Creating referee pointer and adding it to world with priority 1
-    _referee = new Referee(_vision, _replacer, _soccerView, getConstants());
-    _world->addEntity(_referee, 1);
+bool RefereeCore::hasPortConflict(MatchContext *match) {
+    Constants *constants = match->getConstants();
 
-    // Adding replacer to world with prio 0
-    _world->addEntity(_replacer, 0);
+    for(int i = 0; i < _matches.size(); i++) {
+        Constants *other = _matches.at(i)->getConstants();
 
-    // Make GUI connections with modules
-    QObject::connect(_referee, SIGNAL(sendFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)), _soccerView, SLOT(takeFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)));
-    QObject::connect(_referee, SIGNAL(sendTimestamp(float, float, VSSRef::Half, bool)), _soccerView, SLOT(takeTimeStamp(float, float, VSSRef::Half, bool)));
-    QObject::connect(_soccerView, SIGNAL(sendManualFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant, bool)), _referee, SLOT(takeManualFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant, bool)));
-    QObject::connect(_vision, SIGNAL(visionUpdated()), _soccerView->getFieldView(), SLOT(updateField()));
+        // Vision and replacer are bound (multicast groups can be shared if ports differ)
+        bool sameVision = (constants->visionAddress() == other->visionAddress() && constants->visionPort() == other->visionPort());
+        bool sameReplacer = (constants->replacerAddress() == other->replacerAddress() && constants->replacerPort() == other->replacerPort());
 
-    // Show GUI
-    _soccerView->show();
+        // Referee and FIRASim are written
+        bool sameReferee = (constants->refereeAddress() == other->refereeAddress() && constants->refereePort() == other->refereePort());
+        bool sameFira = (constants->firaAddress() == other->firaAddress() && constants->firaPort() == other->firaPort());
+        bool sameBroadcast = (constants->useStateBroadcast() && other->useStateBroadcast() && constants->broadcastAddress() == other->broadcastAddress() && constants->broadcastPort() == other->broadcastPort());
 
-    // Starting entities
-    _world->startEntities();
-}
+        // Shared memory rings are created by name
+        bool sameRings = (constants->useSharedMemory() && other->useSharedMemory() && (constants->visionRing() == other->visionRing() || constants->commandRing() == other->commandRing() || constants->stateRing() == other->stateRing()));
 
-void RefereeCore::stop() {
-    // Stopping and deleting entities
-    _world->stopAndDeleteEntities();
-}
+        // Metrics server is bound
+        bool sameMetrics = (constants->useMetrics() && other->useMetrics() && constants->metricsPort() == other->metricsPort());
 
-Constants* RefereeCore::getConstants() {
-    if(_constants == nullptr) {
-        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at RefereeCore") + '\n';
-    }
-    else {
-        return _constants;
+        if(sameVision || sameReplacer || sameReferee || sameFira || sameBroadcast || sameRings || sameMetrics) {
+            return true;
+        }
     }
 
-    return nullptr;
+    return false;
 }
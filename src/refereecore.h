@@ -1,36 +1,25 @@
 #ifndef REFEREECORE_H
 #define REFEREECORE_H
 
-#include <src/utils/utils.h>
-#include <src/soccerview/soccerview.h>
-#include <src/world/world.h>
-#include <src/world/entities/vision/vision.h>
-#include <src/world/entities/referee/referee.h>
-#include <src/world/entities/replacer/replacer.h>
+#include <src/matchcontext/matchcontext.h>
 
 class RefereeCore
 {
 public:
-    RefereeCore(Constants *constants);
+    RefereeCore();
     ~RefereeCore();
 
+    // Matches management
+    void addMatch(QString constantsFileName);
+
     // Internal
     void start();
     void stop();
 
 private:
-    // Modules
-    World *_world;
-    Vision *_vision;
-    Referee *_referee;
-    Replacer *_replacer;
-
-    // GUI
-    SoccerView *_soccerView;
-
-    // Constants
-    Constants *_constants;
-    Constants* getConstants();
+    // Hosted matches
+    QList<MatchContext*> _matches;
+    bool hasPortConflict(MatchContext *match);
 };
 
 #endif // REFEREECORE_H
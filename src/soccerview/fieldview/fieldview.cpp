@@ -4,7 +4,7 @@
 #define FIELD_COLOR 0.208, 0.208, 0.208, 1.0
 #define FIELD_LINES_COLOR 1.0, 1.0, 1.0, 1.0
 
-FieldView::FieldView(QWidget *parent) : QGLWidget(QGLFormat(QGL::DoubleBuffer | QGL::DepthBuffer | QGL::SampleBuffers), parent) {
+FieldView::FieldView(QWidget *parent) : QGLWidget(QGLFormat(QGL::DoubleBuffer | QGL::DepthBuffer | QGL::SampleBuffers), parent), graphicsMutex("FieldView::graphicsMutex") {
     // Reset view
     resetView();
 
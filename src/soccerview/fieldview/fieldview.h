@@ -2,13 +2,13 @@
 #define FIELDVIEW_H
 
 #include <QGLWidget>
-#include <QMutex>
 #include <QMouseEvent>
 
 #include <src/soccerview/fieldview/gltext/gltext.h>
 #include <src/world/entities/vision/vision.h>
 #include <src/utils/types/field/field_default_3v3.h>
 #include <src/utils/timer/timer.h>
+#include <src/utils/lockprofiler/lockprofiler.h>
 #include <include/vssref_common.pb.h>
 #include <include/packet.pb.h>
 
@@ -76,7 +76,7 @@ private:
     void drawFieldObjects();
 
     // Graphics mutex
-    QMutex graphicsMutex;
+    ProfiledMutex graphicsMutex;
 
     // GLText
     GLText glText;
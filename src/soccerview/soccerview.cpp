@@ -25,7 +25,8 @@ SoccerView::SoccerView(Constants *constants, QWidget *parent) :
     }
 
     // Set scoreboard gameType
-    ui->scoreboard->setTitle(getConstants()->gameType());
+    _stage = getConstants()->gameType();
+    ui->scoreboard->setTitle(_stage);
 
     // Set flag as not visible
     ui->flag->setVisible(false);
@@ -41,15 +42,15 @@ FieldView* SoccerView::getFieldView() {
 }
 
 QString SoccerView::getStage() {
-    return (ui->scoreboard->title());
+    return _stage;
 }
 
 int SoccerView::getLeftTeamGoals() {
-    return _leftTeamGoals;
+    return _leftTeamGoals.load(std::memory_order_acquire);
 }
 
 int SoccerView::getRightTeamGoals() {
-    return _rightTeamGoals;
+    return _rightTeamGoals.load(std::memory_order_acquire);
 }
 
 void SoccerView::setupTeams() {
@@ -97,8 +98,8 @@ void SoccerView::setupTeams() {
 void SoccerView::setupGoals() {
     // Setup goals
     char leftGoal[5], rightGoal[5];
-    sprintf(leftGoal, "%02d", _leftTeamGoals);
-    sprintf(rightGoal, "%02d", _rightTeamGoals);
+    sprintf(leftGoal, "%02d", getLeftTeamGoals());
+    sprintf(rightGoal, "%02d", getRightTeamGoals());
 
     ui->leftTeamGoals->setText(QString("%1").arg(leftGoal));
     ui->rightTeamGoals->setText(QString("%1").arg(rightGoal));
@@ -4,6 +4,8 @@
 #include <QMainWindow>
 #include <QPushButton>
 
+#include <atomic>
+
 #include <src/constants/constants.h>
 #include <src/world/entities/referee/referee.h>
 #include <include/vssref_common.pb.h>
@@ -21,6 +23,8 @@ public:
     ~SoccerView();
 
     FieldView *getFieldView();
+
+    // Match data (also read by the Referee thread, updated at the GUI thread)
     QString getStage();
     int getLeftTeamGoals();
     int getRightTeamGoals();
@@ -48,9 +52,12 @@ private:
     Constants *_constants;
     Constants* getConstants();
 
+    // Stage (taken at construction, the scoreboard widget is only read at the GUI thread)
+    QString _stage;
+
     // Goals
-    int _leftTeamGoals;
-    int _rightTeamGoals;
+    std::atomic<int> _leftTeamGoals;
+    std::atomic<int> _rightTeamGoals;
 
     // Suggestions
     QList<QWidget*> _widgets;
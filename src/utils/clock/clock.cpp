@@ -0,0 +1,39 @@
+#include "clock.h"
+
+Clock::Clock() {
+    // Wall clock by default
+    _isStepped = false;
+
+    // Match starts when clock is created
+    reset();
+}
+
+void Clock::reset() {
+    _startTime = std::chrono::high_resolution_clock::now();
+    _steppedTime = 0;
+}
+
+void Clock::setStepped(bool isStepped) {
+    _isStepped = isStepped;
+}
+
+void Clock::advance(double seconds) {
+    _steppedTime += static_cast<long long>(seconds * 1E9);
+}
+
+std::chrono::high_resolution_clock::time_point Clock::now() {
+    if(isStepped()) {
+        return _startTime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(_steppedTime.load()));
+    }
+
+    return std::chrono::high_resolution_clock::now();
+}
+
+double Clock::getSeconds() {
+    auto passedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now() - _startTime);
+    return (passedTime.count() / 1E9);
+}
+
+bool Clock::isStepped() {
+    return _isStepped;
+}
@@ -0,0 +1,33 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <chrono>
+#include <atomic>
+
+class Clock
+{
+public:
+    Clock();
+
+    // Clock control
+    void reset();
+
+    // Stepped mode (time only passes when advanced, used in lockstep)
+    void setStepped(bool isStepped);
+    void advance(double seconds);
+
+    // Getters
+    std::chrono::high_resolution_clock::time_point now();
+    double getSeconds();
+    bool isStepped();
+
+private:
+    // Match start time
+    std::chrono::high_resolution_clock::time_point _startTime;
+
+    // Stepped time (in ns since start)
+    std::atomic<bool> _isStepped;
+    std::atomic<long long> _steppedTime;
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,327 @@
+#include "latencytracker.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <chrono>
+#include <cmath>
+
+#include <src/utils/logger/logger.h>
+
+LatencyTracker::LatencyTracker(Constants *constants) {
+    // Taking constants
+    _constants = constants;
+
+    // Init frame traces
+    for(int i = 0; i < FRAME_TRACES; i++) {
+        _frames[i] = {0, 0, 0, 0, 0};
+    }
+    _lastTraceId = 0;
+    _lastPublishedId = 0;
+    _lastPickedId = 0;
+
+    // Init evaluation and decision
+    _evaluatedFrame = {0, 0, 0, 0, 0};
+    _evaluationStart = 0;
+    _hasPendingDecision = false;
+    _isDispatched = false;
+    _decisions = 0;
+
+    // Init histograms
+    for(int i = 0; i < STAGE_COUNT; i++) {
+        for(int j = 0; j < HISTOGRAM_BUCKETS; j++) {
+            _histograms[i].buckets[j] = 0;
+        }
+        _histograms[i].count = 0;
+        _histograms[i].sum = 0.0;
+        _histograms[i].max = 0.0;
+    }
+}
+
+std::string LatencyTracker::stageName(Stage stage) {
+    switch(stage) {
+        case STAGE_DECODE: return "decode";
+        case STAGE_FILTER: return "filter";
+        case STAGE_PUBLISH: return "publish";
+        case STAGE_PICKUP: return "pickup";
+        case STAGE_EVALUATE: return "evaluate";
+        case STAGE_DISPATCH: return "dispatch";
+        case STAGE_SEND: return "send";
+        case STAGE_TOTAL: return "total";
+        default: return "unknown";
+    }
+}
+
+quint64 LatencyTracker::beginFrame() {
+    qint64 received = now();
+
+    _mutex.lock();
+    quint64 traceId = ++_lastTraceId;
+    FrameTrace *frame = frameAt(traceId);
+    *frame = {traceId, received, received, received, received};
+    _mutex.unlock();
+
+    return traceId;
+}
+
+void LatencyTracker::markDecoded(quint64 traceId) {
+    qint64 decoded = now();
+
+    _mutex.lock();
+    FrameTrace *frame = frameAt(traceId);
+    if(frame->traceId == traceId) {
+        frame->decoded = decoded;
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::markFiltered(quint64 traceId) {
+    qint64 filtered = now();
+
+    _mutex.lock();
+    FrameTrace *frame = frameAt(traceId);
+    if(frame->traceId == traceId) {
+        frame->filtered = filtered;
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::markPublished(quint64 traceId) {
+    qint64 published = now();
+
+    _mutex.lock();
+    FrameTrace *frame = frameAt(traceId);
+    if(frame->traceId == traceId) {
+        frame->published = published;
+        _lastPublishedId = traceId;
+
+        // Vision stages are taken for every frame
+        addSample(STAGE_DECODE, frame->decoded - frame->received);
+        addSample(STAGE_FILTER, frame->filtered - frame->decoded);
+        addSample(STAGE_PUBLISH, frame->published - frame->filtered);
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::beginEvaluation() {
+    qint64 evaluationStart = now();
+
+    _mutex.lock();
+    // Take last published frame (the snapshot checkers will read)
+    FrameTrace *frame = frameAt(_lastPublishedId);
+    if(_lastPublishedId != 0 && frame->traceId == _lastPublishedId) {
+        _evaluatedFrame = *frame;
+
+        // Pickup is taken once per frame
+        if(_lastPickedId != _lastPublishedId) {
+            addSample(STAGE_PICKUP, evaluationStart - frame->published);
+            _lastPickedId = _lastPublishedId;
+        }
+    }
+    else {
+        _evaluatedFrame.traceId = 0;
+    }
+    _evaluationStart = evaluationStart;
+    _mutex.unlock();
+}
+
+void LatencyTracker::endEvaluation() {
+    qint64 evaluationEnd = now();
+
+    _mutex.lock();
+    addSample(STAGE_EVALUATE, evaluationEnd - _evaluationStart);
+    _mutex.unlock();
+}
+
+void LatencyTracker::markFoul() {
+    qint64 fouled = now();
+
+    _mutex.lock();
+    // Keep the first foul until it is sent (checkers can emit again before dispatch)
+    if(!_hasPendingDecision && _evaluatedFrame.traceId != 0) {
+        _pendingDecision.frame = _evaluatedFrame;
+        _pendingDecision.evaluated = _evaluationStart;
+        _pendingDecision.fouled = fouled;
+        _pendingDecision.dispatched = fouled;
+        _pendingDecision.sent = fouled;
+        _pendingDecision.foul = VSSRef::Foul::GAME_ON;
+        _hasPendingDecision = true;
+        _isDispatched = false;
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::markDispatch() {
+    qint64 dispatched = now();
+
+    _mutex.lock();
+    if(_hasPendingDecision && !_isDispatched) {
+        _pendingDecision.dispatched = dispatched;
+        _isDispatched = true;
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::cancelDecision() {
+    _mutex.lock();
+    _hasPendingDecision = false;
+    _isDispatched = false;
+    _mutex.unlock();
+}
+
+void LatencyTracker::markSent(VSSRef::Foul foul) {
+    qint64 sent = now();
+
+    _mutex.lock();
+    // Only commands that come from a dispatched foul close the decision
+    if(_hasPendingDecision && _isDispatched) {
+        _pendingDecision.sent = sent;
+        _pendingDecision.foul = foul;
+        finishDecision();
+        _hasPendingDecision = false;
+        _isDispatched = false;
+    }
+    _mutex.unlock();
+}
+
+void LatencyTracker::finishDecision() {
+    const DecisionTrace &decision = _pendingDecision;
+
+    // Decision stages
+    addSample(STAGE_DISPATCH, decision.dispatched - decision.fouled);
+    addSample(STAGE_SEND, decision.sent - decision.dispatched);
+    addSample(STAGE_TOTAL, decision.sent - decision.frame.received);
+    _decisions++;
+
+    // Check if it is a slow decision
+    double totalTime = (decision.sent - decision.frame.received) / 1E6;
+    if(totalTime >= getConstants()->slowDecisionTime()) {
+        if(_slowDecisions.size() >= SLOW_DECISIONS) {
+            _slowDecisions.removeFirst();
+        }
+        _slowDecisions.push_back(decision);
+
+        Logger::warning("LATENCY", "Slow decision '%s' %s", VSSRef::Foul_Name(decision.foul).c_str(), decisionToString(decision).c_str());
+    }
+}
+
+std::string LatencyTracker::decisionToString(const DecisionTrace &decision) {
+    qint64 stages[STAGE_COUNT] = {
+        decision.frame.decoded - decision.frame.received,
+        decision.frame.filtered - decision.frame.decoded,
+        decision.frame.published - decision.frame.filtered,
+        decision.evaluated - decision.frame.published,
+        decision.fouled - decision.evaluated,
+        decision.dispatched - decision.fouled,
+        decision.sent - decision.dispatched,
+        decision.sent - decision.frame.received
+    };
+
+    std::string str = "(trace " + std::to_string(decision.frame.traceId) + ")";
+    for(int i = 0; i < STAGE_COUNT; i++) {
+        str += " " + stageName(Stage(i)) + ": " + std::to_string(stages[i] / 1E6) + "ms";
+    }
+
+    return str;
+}
+
+void LatencyTracker::addSample(Stage stage, qint64 nanoSeconds) {
+    Histogram &histogram = _histograms[stage];
+    double microSeconds = std::max(0.0, nanoSeconds / 1E3);
+
+    // Bucket i takes samples below 2^i us
+    int bucket = 0;
+    if(microSeconds >= 1.0) {
+        bucket = std::min(HISTOGRAM_BUCKETS - 1, static_cast<int>(std::floor(std::log2(microSeconds))) + 1);
+    }
+
+    histogram.buckets[bucket]++;
+    histogram.count++;
+    histogram.sum += microSeconds;
+    histogram.max = std::max(histogram.max, microSeconds);
+}
+
+double LatencyTracker::percentile(const Histogram &histogram, double fraction) {
+    if(histogram.count == 0) {
+        return 0.0;
+    }
+
+    // Take upper bound of the bucket that reaches the fraction
+    quint64 samples = 0;
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        samples += histogram.buckets[i];
+        if(samples >= fraction * histogram.count) {
+            return std::min(histogram.max, std::pow(2.0, i));
+        }
+    }
+
+    return histogram.max;
+}
+
+void LatencyTracker::printReport() {
+    _mutex.lock();
+    std::cout << Text::blue("[LATENCY] ", true) + Text::bold("Traced " + std::to_string(_lastTraceId) + " frames and " + std::to_string(_decisions) + " decisions.") + '\n';
+    for(int i = 0; i < STAGE_COUNT; i++) {
+        const Histogram &histogram = _histograms[i];
+        if(histogram.count == 0) {
+            continue;
+        }
+
+        std::cout << Text::blue("[LATENCY] ", true) + Text::bold(stageName(Stage(i)) + ": mean " + std::to_string(histogram.sum / histogram.count / 1E3) + "ms, p50 " + std::to_string(percentile(histogram, 0.5) / 1E3) + "ms, p99 " + std::to_string(percentile(histogram, 0.99) / 1E3) + "ms, max " + std::to_string(histogram.max / 1E3) + "ms (" + std::to_string(histogram.count) + " samples)") + '\n';
+    }
+    _mutex.unlock();
+}
+
+bool LatencyTracker::exportReport(QString fileName) {
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::cout << Text::blue("[LATENCY] ", true) << Text::red("Error while opening '" + fileName.toStdString() + "'.", true) + '\n';
+        return false;
+    }
+
+    _mutex.lock();
+    QTextStream stream(&file);
+    stream << "{\n  \"frames\": " << _lastTraceId << ",\n  \"decisions\": " << _decisions << ",\n  \"stages\": [\n";
+    for(int i = 0; i < STAGE_COUNT; i++) {
+        const Histogram &histogram = _histograms[i];
+        double mean = (histogram.count == 0) ? 0.0 : histogram.sum / histogram.count;
+
+        stream << "    {\"name\": \"" << QString::fromStdString(stageName(Stage(i))) << "\", \"count\": " << histogram.count << ", \"mean_us\": " << mean << ", \"p50_us\": " << percentile(histogram, 0.5) << ", \"p99_us\": " << percentile(histogram, 0.99) << ", \"max_us\": " << histogram.max << ", \"buckets\": [";
+        for(int j = 0; j < HISTOGRAM_BUCKETS; j++) {
+            stream << "{\"le_us\": " << std::pow(2.0, j) << ", \"count\": " << histogram.buckets[j] << "}" << ((j + 1 < HISTOGRAM_BUCKETS) ? ", " : "");
+        }
+        stream << "]}" << ((i + 1 < STAGE_COUNT) ? "," : "") << "\n";
+    }
+    stream << "  ],\n  \"slow_decisions\": [\n";
+    for(int i = 0; i < _slowDecisions.size(); i++) {
+        const DecisionTrace &decision = _slowDecisions.at(i);
+        stream << "    {\"trace\": " << decision.frame.traceId << ", \"foul\": \"" << QString::fromStdString(VSSRef::Foul_Name(decision.foul)) << "\", \"received\": " << decision.frame.received << ", \"decoded\": " << decision.frame.decoded << ", \"filtered\": " << decision.frame.filtered << ", \"published\": " << decision.frame.published << ", \"evaluated\": " << decision.evaluated << ", \"fouled\": " << decision.fouled << ", \"dispatched\": " << decision.dispatched << ", \"sent\": " << decision.sent << "}" << ((i + 1 < _slowDecisions.size()) ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+    _mutex.unlock();
+
+    file.close();
+
+    std::cout << Text::blue("[LATENCY] ", true) + Text::bold("Report written to '" + fileName.toStdString() + "'.") + '\n';
+
+    return true;
+}
+
+qint64 LatencyTracker::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LatencyTracker::FrameTrace* LatencyTracker::frameAt(quint64 traceId) {
+    return &_frames[traceId % FRAME_TRACES];
+}
+
+Constants* LatencyTracker::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at LatencyTracker") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,108 @@
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <QMutex>
+#include <QVector>
+
+#include <src/constants/constants.h>
+#include <include/vssref_common.pb.h>
+
+class LatencyTracker
+{
+public:
+    LatencyTracker(Constants *constants);
+
+    // Stages of a decision (from datagram arrival to command sent)
+    enum Stage {
+        STAGE_DECODE,
+        STAGE_FILTER,
+        STAGE_PUBLISH,
+        STAGE_PICKUP,
+        STAGE_EVALUATE,
+        STAGE_DISPATCH,
+        STAGE_SEND,
+        STAGE_TOTAL,
+        STAGE_COUNT
+    };
+    static std::string stageName(Stage stage);
+
+    // Vision side (one trace per frame)
+    quint64 beginFrame();
+    void markDecoded(quint64 traceId);
+    void markFiltered(quint64 traceId);
+    void markPublished(quint64 traceId);
+
+    // Referee side (evaluation of the last published frame and decision taken from it)
+    void beginEvaluation();
+    void endEvaluation();
+    void markFoul();
+    void markDispatch();
+    void cancelDecision();
+    void markSent(VSSRef::Foul foul);
+
+    // Report
+    void printReport();
+    bool exportReport(QString fileName);
+
+private:
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Time source (steady, not the match clock)
+    static qint64 now();
+
+    // Frame traces (ring indexed by trace id)
+    struct FrameTrace {
+        quint64 traceId;
+        qint64 received;
+        qint64 decoded;
+        qint64 filtered;
+        qint64 published;
+    };
+    static const int FRAME_TRACES = 64;
+    FrameTrace _frames[FRAME_TRACES];
+    quint64 _lastTraceId;
+    quint64 _lastPublishedId;
+    FrameTrace* frameAt(quint64 traceId);
+
+    // Evaluation and pending decision
+    FrameTrace _evaluatedFrame;
+    qint64 _evaluationStart;
+    quint64 _lastPickedId;
+    struct DecisionTrace {
+        FrameTrace frame;
+        qint64 evaluated;
+        qint64 fouled;
+        qint64 dispatched;
+        qint64 sent;
+        VSSRef::Foul foul;
+    };
+    DecisionTrace _pendingDecision;
+    bool _hasPendingDecision;
+    bool _isDispatched;
+    quint64 _decisions;
+
+    // Histograms (log2 buckets in microseconds)
+    static const int HISTOGRAM_BUCKETS = 24;
+    struct Histogram {
+        quint64 buckets[HISTOGRAM_BUCKETS];
+        quint64 count;
+        double sum;
+        double max;
+    };
+    Histogram _histograms[STAGE_COUNT];
+    void addSample(Stage stage, qint64 nanoSeconds);
+    double percentile(const Histogram &histogram, double fraction);
+
+    // Slow decisions log
+    static const int SLOW_DECISIONS = 32;
+    QVector<DecisionTrace> _slowDecisions;
+    void finishDecision();
+    std::string decisionToString(const DecisionTrace &decision);
+
+    // Data management
+    QMutex _mutex;
+};
+
+#endif // LATENCYTRACKER_H
@@ -0,0 +1,348 @@
+#include "lockprofiler.h"
+
+#include <chrono>
+#include <algorithm>
+
+#include <src/utils/text/text.h>
+
+std::atomic<bool> LockProfiler::_isEnabled(false);
+QList<LockStats*> LockProfiler::_locks;
+QList<std::string*> LockProfiler::_threadNames;
+QMutex LockProfiler::_registryMutex;
+
+// Calling thread info
+static thread_local const char *currentThreadName = nullptr;
+struct ReadHold {
+    const void *lock;
+    qint64 acquiredAt;
+};
+static thread_local ReadHold currentReadHolds[8];
+static thread_local int currentReadDepth = 0;
+
+void LockProfiler::startProfiling() {
+    _isEnabled = true;
+
+    std::cout << Text::blue("[LOCKS] ", true) + Text::bold("Lock contention profiling enabled.") + '\n';
+}
+
+void LockProfiler::setThreadName(const std::string &threadName) {
+    currentThreadName = internThreadName(threadName);
+}
+
+const char* LockProfiler::threadName() {
+    if(currentThreadName == nullptr) {
+        return "unnamed";
+    }
+
+    return currentThreadName;
+}
+
+const char* LockProfiler::internThreadName(const std::string &threadName) {
+    _registryMutex.lock();
+
+    // Take already interned name
+    for(int i = 0; i < _threadNames.size(); i++) {
+        if(*_threadNames.at(i) == threadName) {
+            const char *name = _threadNames.at(i)->c_str();
+            _registryMutex.unlock();
+            return name;
+        }
+    }
+
+    std::string *name = new std::string(threadName);
+    _threadNames.push_back(name);
+
+    _registryMutex.unlock();
+
+    return name->c_str();
+}
+
+LockStats* LockProfiler::registerLock(const std::string &lockName) {
+    _registryMutex.lock();
+
+    // Locks with the same name share stats (same lock at different matches)
+    for(int i = 0; i < _locks.size(); i++) {
+        if(_locks.at(i)->name == lockName) {
+            LockStats *stats = _locks.at(i);
+            _registryMutex.unlock();
+            return stats;
+        }
+    }
+
+    LockStats *stats = new LockStats();
+    stats->name = lockName;
+    stats->acquisitions = 0;
+    stats->contentions = 0;
+    stats->waitTime = 0;
+    stats->maxWaitTime = 0;
+    stats->holdTime = 0;
+    stats->maxHoldTime = 0;
+    for(int i = 0; i < LockStats::HOLDERS; i++) {
+        stats->holders[i].threadName = nullptr;
+        stats->holders[i].contentions = 0;
+        stats->holders[i].waitTime = 0;
+    }
+    _locks.push_back(stats);
+
+    _registryMutex.unlock();
+
+    return stats;
+}
+
+qint64 LockProfiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LockProfiler::updateMax(std::atomic<quint64> &max, quint64 value) {
+    quint64 current = max.load(std::memory_order_relaxed);
+    while(value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+void LockProfiler::addWait(LockStats *stats, const char *holderName, qint64 waitTime) {
+    quint64 time = static_cast<quint64>(std::max(qint64(0), waitTime));
+
+    stats->contentions.fetch_add(1, std::memory_order_relaxed);
+    stats->waitTime.fetch_add(time, std::memory_order_relaxed);
+    updateMax(stats->maxWaitTime, time);
+
+    // Blame holder thread (names are interned, so pointers are compared)
+    if(holderName == nullptr) {
+        holderName = "unknown";
+    }
+    for(int i = 0; i < LockStats::HOLDERS; i++) {
+        LockStats::Holder &holder = stats->holders[i];
+        const char *slotName = holder.threadName.load(std::memory_order_acquire);
+        if(slotName == nullptr) {
+            // Take free slot (other thread can take it first)
+            if(!holder.threadName.compare_exchange_strong(slotName, holderName, std::memory_order_acq_rel) && slotName != holderName) {
+                continue;
+            }
+        }
+        else if(slotName != holderName) {
+            continue;
+        }
+
+        holder.contentions.fetch_add(1, std::memory_order_relaxed);
+        holder.waitTime.fetch_add(time, std::memory_order_relaxed);
+        break;
+    }
+}
+
+void LockProfiler::addHold(LockStats *stats, qint64 holdTime) {
+    quint64 time = static_cast<quint64>(std::max(qint64(0), holdTime));
+
+    stats->holdTime.fetch_add(time, std::memory_order_relaxed);
+    updateMax(stats->maxHoldTime, time);
+}
+
+std::string LockProfiler::report() {
+    _registryMutex.lock();
+    QList<LockStats*> locks = _locks;
+    _registryMutex.unlock();
+
+    // Most waited locks first
+    std::sort(locks.begin(), locks.end(), [](LockStats *a, LockStats *b) { return a->waitTime.load() > b->waitTime.load(); });
+
+    std::string report;
+    for(int i = 0; i < locks.size(); i++) {
+        LockStats *stats = locks.at(i);
+        quint64 acquisitions = stats->acquisitions.load();
+        quint64 contentions = stats->contentions.load();
+        if(acquisitions == 0) {
+            continue;
+        }
+
+        report += stats->name + ": " + std::to_string(acquisitions) + " acquisitions, " + std::to_string(contentions) + " contended (" + std::to_string(100.0 * contentions / acquisitions) + "%)"
+                + ", wait total " + std::to_string(stats->waitTime.load() / 1E6) + "ms max " + std::to_string(stats->maxWaitTime.load() / 1E6) + "ms"
+                + ", hold mean " + std::to_string(stats->holdTime.load() / 1E6 / acquisitions) + "ms max " + std::to_string(stats->maxHoldTime.load() / 1E6) + "ms\n";
+
+        for(int j = 0; j < LockStats::HOLDERS; j++) {
+            const LockStats::Holder &holder = stats->holders[j];
+            const char *holderName = holder.threadName.load();
+            if(holderName == nullptr) {
+                break;
+            }
+
+            report += "    held by " + std::string(holderName) + ": " + std::to_string(holder.contentions.load()) + " contentions, " + std::to_string(holder.waitTime.load() / 1E6) + "ms waited\n";
+        }
+    }
+
+    return report;
+}
+
+void LockProfiler::printReport() {
+    if(!isEnabled()) {
+        return ;
+    }
+
+    std::cout << Text::blue("[LOCKS] ", true) + Text::bold("Lock contention report:") + '\n' + report();
+}
+
+ProfiledMutex::ProfiledMutex(const std::string &lockName) {
+    _stats = LockProfiler::registerLock(lockName);
+    _holder = nullptr;
+    _acquiredAt = 0;
+}
+
+void ProfiledMutex::lock() {
+    if(!LockProfiler::isEnabled()) {
+        _mutex.lock();
+        return ;
+    }
+
+    // Uncontended path
+    if(_mutex.tryLock()) {
+        acquired();
+        return ;
+    }
+
+    // Contended, take holder before blocking
+    const char *holder = _holder.load(std::memory_order_relaxed);
+    qint64 waitStart = LockProfiler::now();
+    _mutex.lock();
+    LockProfiler::addWait(_stats, holder, LockProfiler::now() - waitStart);
+
+    acquired();
+}
+
+bool ProfiledMutex::tryLock() {
+    if(!_mutex.tryLock()) {
+        return false;
+    }
+
+    if(LockProfiler::isEnabled()) {
+        acquired();
+    }
+
+    return true;
+}
+
+void ProfiledMutex::unlock() {
+    // Lock could be taken before profiling started
+    if(LockProfiler::isEnabled() && _acquiredAt != 0) {
+        LockProfiler::addHold(_stats, LockProfiler::now() - _acquiredAt);
+        _acquiredAt = 0;
+        _holder.store(nullptr, std::memory_order_relaxed);
+    }
+
+    _mutex.unlock();
+}
+
+bool ProfiledMutex::wait(QWaitCondition *condition, unsigned long time) {
+    // Mutex is released while waiting
+    if(LockProfiler::isEnabled() && _acquiredAt != 0) {
+        LockProfiler::addHold(_stats, LockProfiler::now() - _acquiredAt);
+        _acquiredAt = 0;
+        _holder.store(nullptr, std::memory_order_relaxed);
+    }
+
+    bool isWoken = condition->wait(&_mutex, time);
+
+    if(LockProfiler::isEnabled()) {
+        acquired();
+    }
+
+    return isWoken;
+}
+
+void ProfiledMutex::acquired() {
+    _stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    _holder.store(LockProfiler::threadName(), std::memory_order_relaxed);
+    _acquiredAt = LockProfiler::now();
+}
+
+ProfiledReadWriteLock::ProfiledReadWriteLock(const std::string &lockName) {
+    _stats = LockProfiler::registerLock(lockName);
+    _holder = nullptr;
+    _isWriteLocked = false;
+    _writeAcquiredAt = 0;
+}
+
+void ProfiledReadWriteLock::lockForRead() {
+    if(!LockProfiler::isEnabled()) {
+        _lock.lockForRead();
+        return ;
+    }
+
+    // Contended only if a writer holds (or waits for) the lock
+    if(!_lock.tryLockForRead()) {
+        const char *holder = _holder.load(std::memory_order_relaxed);
+        qint64 waitStart = LockProfiler::now();
+        _lock.lockForRead();
+        LockProfiler::addWait(_stats, holder, LockProfiler::now() - waitStart);
+    }
+
+    _stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    _holder.store(LockProfiler::threadName(), std::memory_order_relaxed);
+    pushRead(LockProfiler::now());
+}
+
+void ProfiledReadWriteLock::lockForWrite() {
+    if(!LockProfiler::isEnabled()) {
+        _lock.lockForWrite();
+        return ;
+    }
+
+    // Contended by readers or other writer (holder is the last one that took it)
+    if(!_lock.tryLockForWrite()) {
+        const char *holder = _holder.load(std::memory_order_relaxed);
+        qint64 waitStart = LockProfiler::now();
+        _lock.lockForWrite();
+        LockProfiler::addWait(_stats, holder, LockProfiler::now() - waitStart);
+    }
+
+    _stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    _holder.store(LockProfiler::threadName(), std::memory_order_relaxed);
+    _isWriteLocked.store(true, std::memory_order_relaxed);
+    _writeAcquiredAt = LockProfiler::now();
+}
+
+void ProfiledReadWriteLock::unlock() {
+    if(LockProfiler::isEnabled()) {
+        // Only the writer can unlock while write locked
+        if(_isWriteLocked.load(std::memory_order_relaxed)) {
+            if(_writeAcquiredAt != 0) {
+                LockProfiler::addHold(_stats, LockProfiler::now() - _writeAcquiredAt);
+            }
+            _writeAcquiredAt = 0;
+            _isWriteLocked.store(false, std::memory_order_relaxed);
+        }
+        else {
+            qint64 acquiredAt = popRead();
+            if(acquiredAt != 0) {
+                LockProfiler::addHold(_stats, LockProfiler::now() - acquiredAt);
+            }
+        }
+    }
+
+    _lock.unlock();
+}
+
+void ProfiledReadWriteLock::pushRead(qint64 acquiredAt) {
+    if(currentReadDepth < READ_DEPTH) {
+        currentReadHolds[currentReadDepth] = {this, acquiredAt};
+    }
+    currentReadDepth++;
+}
+
+qint64 ProfiledReadWriteLock::popRead() {
+    // Take the last read hold of this lock at the calling thread
+    int depth = std::min(currentReadDepth, READ_DEPTH);
+    for(int i = depth - 1; i >= 0; i--) {
+        if(currentReadHolds[i].lock == this) {
+            qint64 acquiredAt = currentReadHolds[i].acquiredAt;
+            for(int j = i; j < depth - 1; j++) {
+                currentReadHolds[j] = currentReadHolds[j + 1];
+            }
+            currentReadDepth--;
+            return acquiredAt;
+        }
+    }
+
+    // Hold deeper than the tracked ones
+    if(currentReadDepth > READ_DEPTH) {
+        currentReadDepth--;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef LOCKPROFILER_H
+#define LOCKPROFILER_H
+
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QWaitCondition>
+#include <QList>
+
+#include <atomic>
+#include <string>
+
+// Contention stats of a named lock (shared by all locks with the same name)
+struct LockStats {
+    std::string name;
+    std::atomic<quint64> acquisitions;
+    std::atomic<quint64> contentions;
+    std::atomic<quint64> waitTime;
+    std::atomic<quint64> maxWaitTime;
+    std::atomic<quint64> holdTime;
+    std::atomic<quint64> maxHoldTime;
+
+    // Threads holding the lock when it was contended
+    static const int HOLDERS = 8;
+    struct Holder {
+        std::atomic<const char*> threadName;
+        std::atomic<quint64> contentions;
+        std::atomic<quint64> waitTime;
+    };
+    Holder holders[HOLDERS];
+};
+
+class LockProfiler
+{
+public:
+    // Profiler control (opt-in, process wide, must be started before the matches)
+    static void startProfiling();
+    static bool isEnabled() { return _isEnabled.load(std::memory_order_relaxed); }
+
+    // Threads are identified by name in the report
+    static void setThreadName(const std::string &threadName);
+    static const char* threadName();
+
+    // Locks registry
+    static LockStats* registerLock(const std::string &lockName);
+
+    // Report (locks sorted by total wait time)
+    static std::string report();
+    static void printReport();
+
+    // Stats update
+    static qint64 now();
+    static void addWait(LockStats *stats, const char *holderName, qint64 waitTime);
+    static void addHold(LockStats *stats, qint64 holdTime);
+
+private:
+    static std::atomic<bool> _isEnabled;
+
+    // Registered locks and interned thread names (never freed, they are referenced by the stats)
+    static QList<LockStats*> _locks;
+    static QList<std::string*> _threadNames;
+    static QMutex _registryMutex;
+    static const char* internThreadName(const std::string &threadName);
+
+    static void updateMax(std::atomic<quint64> &max, quint64 value);
+};
+
+// QMutex recording wait, hold and holder thread
+class ProfiledMutex
+{
+public:
+    ProfiledMutex(const std::string &lockName);
+
+    void lock();
+    bool tryLock();
+    void unlock();
+
+    // Wait on condition (time waiting is not taken as held)
+    bool wait(QWaitCondition *condition, unsigned long time);
+
+private:
+    QMutex _mutex;
+    LockStats *_stats;
+    std::atomic<const char*> _holder;
+    qint64 _acquiredAt;
+    void acquired();
+};
+
+// QReadWriteLock recording wait, hold and holder thread
+class ProfiledReadWriteLock
+{
+public:
+    ProfiledReadWriteLock(const std::string &lockName);
+
+    void lockForRead();
+    void lockForWrite();
+    void unlock();
+
+private:
+    QReadWriteLock _lock;
+    LockStats *_stats;
+    std::atomic<const char*> _holder;
+    std::atomic<bool> _isWriteLocked;
+    qint64 _writeAcquiredAt;
+
+    // Readers hold times are kept per thread
+    static const int READ_DEPTH = 8;
+    void pushRead(qint64 acquiredAt);
+    qint64 popRead();
+};
+
+#endif // LOCKPROFILER_H
@@ -0,0 +1,306 @@
+#include "logger.h"
+
+#include <chrono>
+#include <cstdio>
+
+Logger* Logger::_instance = nullptr;
+std::atomic<int> Logger::_minLevel(Logger::LEVEL_INFO);
+
+Logger::Logger(Level level, bool toTerminal, QString fileName, int rateLimit) {
+    // Init queue slots
+    for(quint32 i = 0; i < QUEUE_SIZE; i++) {
+        _slots[i].sequence = i;
+    }
+    _enqueuePosition = 0;
+    _dequeuePosition = 0;
+    _dropped = 0;
+
+    // Init rate slots
+    for(int i = 0; i < RATE_SLOTS; i++) {
+        _rateSlots[i].window = -1;
+        _rateSlots[i].count = 0;
+        _rateSlots[i].suppressed = 0;
+    }
+    _rateLimit = rateLimit;
+
+    // Sinks
+    _toTerminal = toTerminal;
+    if(!fileName.isEmpty()) {
+        _file.setFileName(fileName);
+        if(!_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            std::cout << Text::blue("[LOGGER] ", true) << Text::red("Error while opening '" + fileName.toStdString() + "'.", true) + '\n';
+        }
+    }
+
+    _minLevel = level;
+    _isRunning = true;
+}
+
+Logger::Level Logger::levelFromName(QString levelName, bool *ok) {
+    QString name = levelName.toLower();
+    if(ok != nullptr) {
+        *ok = true;
+    }
+
+    if(name == "debug") {
+        return LEVEL_DEBUG;
+    }
+    else if(name == "info") {
+        return LEVEL_INFO;
+    }
+    else if(name == "warning") {
+        return LEVEL_WARNING;
+    }
+    else if(name == "error") {
+        return LEVEL_ERROR;
+    }
+
+    if(ok != nullptr) {
+        *ok = false;
+    }
+
+    return LEVEL_INFO;
+}
+
+std::string Logger::levelName(Level level) {
+    switch(level) {
+        case LEVEL_DEBUG: return "DEBUG";
+        case LEVEL_INFO: return "INFO";
+        case LEVEL_WARNING: return "WARNING";
+        case LEVEL_ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
+void Logger::startLogger(Level level, bool toTerminal, QString fileName, int rateLimit) {
+    if(_instance != nullptr) {
+        return ;
+    }
+
+    // Create and start writer thread
+    _instance = new Logger(level, toTerminal, fileName, rateLimit);
+    _instance->start();
+}
+
+void Logger::stopLogger() {
+    if(_instance == nullptr) {
+        return ;
+    }
+
+    // Next records are written synchronously
+    Logger *logger = _instance;
+    _instance = nullptr;
+
+    // Wait writer to flush queue
+    logger->_isRunning = false;
+    logger->wait();
+
+    delete logger;
+}
+
+void Logger::debug(const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log(LEVEL_DEBUG, module, format, args);
+    va_end(args);
+}
+
+void Logger::info(const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log(LEVEL_INFO, module, format, args);
+    va_end(args);
+}
+
+void Logger::warning(const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log(LEVEL_WARNING, module, format, args);
+    va_end(args);
+}
+
+void Logger::error(const char *module, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log(LEVEL_ERROR, module, format, args);
+    va_end(args);
+}
+
+void Logger::log(Level level, const char *module, const char *format, va_list args) {
+    // Check level
+    if(level < _minLevel.load(std::memory_order_relaxed)) {
+        return ;
+    }
+
+    // Fill record
+    Record record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    record.level = level;
+    record.module = module;
+    record.suppressed = 0;
+
+    // Without a started logger, write it synchronously
+    Logger *logger = _instance;
+    if(logger == nullptr) {
+        vsnprintf(record.message, sizeof(record.message), format, args);
+        writeTerminal(record);
+        return ;
+    }
+
+    // Check rate of this call site
+    if(!logger->takeRate(format, record.timestamp, &record.suppressed)) {
+        return ;
+    }
+
+    vsnprintf(record.message, sizeof(record.message), format, args);
+
+    // Enqueue (dropped if the writer is behind)
+    if(!logger->push(record)) {
+        logger->_dropped++;
+    }
+}
+
+bool Logger::takeRate(const char *format, qint64 timestamp, quint32 *suppressed) {
+    if(_rateLimit <= 0) {
+        return true;
+    }
+
+    // Call sites are identified by their format string
+    RateSlot &slot = _rateSlots[(reinterpret_cast<quintptr>(format) >> 4) % RATE_SLOTS];
+
+    // New window (1 second), report suppressed records of the last one
+    qint64 window = timestamp / 1000;
+    if(slot.window.exchange(window) != window) {
+        slot.count = 0;
+        *suppressed = slot.suppressed.exchange(0);
+    }
+
+    if(slot.count.fetch_add(1) >= _rateLimit) {
+        slot.suppressed++;
+        return false;
+    }
+
+    return true;
+}
+
+bool Logger::push(const Record &record) {
+    quint64 position = _enqueuePosition.load(std::memory_order_relaxed);
+
+    while(true) {
+        Slot &slot = _slots[position % QUEUE_SIZE];
+        quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+        qint64 difference = static_cast<qint64>(sequence) - static_cast<qint64>(position);
+
+        // Free slot, try to take it
+        if(difference == 0) {
+            if(_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        // Queue is full
+        else if(difference < 0) {
+            return false;
+        }
+        // Other producer took it, reload position
+        else {
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::pop(Record *record) {
+    Slot &slot = _slots[_dequeuePosition % QUEUE_SIZE];
+    quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+
+    // Slot not published yet
+    if(sequence != _dequeuePosition + 1) {
+        return false;
+    }
+
+    *record = slot.record;
+    slot.sequence.store(_dequeuePosition + QUEUE_SIZE, std::memory_order_release);
+    _dequeuePosition++;
+
+    return true;
+}
+
+void Logger::writeTerminal(const Record &record) {
+    std::string message = record.message;
+    if(record.suppressed > 0) {
+        message += " (" + std::to_string(record.suppressed) + " similar records suppressed)";
+    }
+
+    // Text formats the record by level
+    switch(record.level) {
+        case LEVEL_DEBUG: std::cout << Text::record(record.module, message, Text::DEFAULT, false); break;
+        case LEVEL_INFO: std::cout << Text::record(record.module, message, Text::DEFAULT, true); break;
+        case LEVEL_WARNING: std::cout << Text::record(record.module, message, Text::YELLOW, true); break;
+        case LEVEL_ERROR: std::cout << Text::record(record.module, message, Text::RED, true); break;
+    }
+}
+
+void Logger::writeFile(const Record &record) {
+    // Escaping message for json
+    std::string message;
+    for(const char *c = record.message; *c != '\0'; c++) {
+        if(*c == '"' || *c == '\\') {
+            message += '\\';
+            message += *c;
+        }
+        else if(static_cast<unsigned char>(*c) >= 0x20) {
+            message += *c;
+        }
+    }
+
+    // One json object per line
+    std::string line = "{\"ts\": " + std::to_string(record.timestamp) + ", \"level\": \"" + levelName(record.level) + "\", \"module\": \"" + record.module + "\", \"message\": \"" + message + "\", \"suppressed\": " + std::to_string(record.suppressed) + "}\n";
+    _file.write(line.c_str(), line.size());
+}
+
+void Logger::run() {
+    Record record;
+
+    while(_isRunning) {
+        bool hasRecords = false;
+
+        // Write available records
+        while(pop(&record)) {
+            if(_toTerminal) {
+                writeTerminal(record);
+            }
+            if(_file.isOpen()) {
+                writeFile(record);
+            }
+            hasRecords = true;
+        }
+
+        if(_file.isOpen() && hasRecords) {
+            _file.flush();
+        }
+
+        // Wait for new records
+        if(!hasRecords) {
+            msleep(5);
+        }
+    }
+
+    // Flush remaining records
+    while(pop(&record)) {
+        if(_toTerminal) {
+            writeTerminal(record);
+        }
+        if(_file.isOpen()) {
+            writeFile(record);
+        }
+    }
+
+    if(_file.isOpen()) {
+        _file.close();
+    }
+
+    if(_dropped.load() > 0) {
+        std::cout << Text::blue("[LOGGER] ", true) + Text::yellow("Dropped " + std::to_string(_dropped.load()) + " records (queue full).", true) + '\n';
+    }
+}
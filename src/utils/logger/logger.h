@@ -0,0 +1,87 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QThread>
+#include <QFile>
+
+#include <atomic>
+#include <cstdarg>
+
+#include <src/utils/text/text.h>
+
+class Logger : public QThread
+{
+public:
+    // Log levels
+    enum Level {
+        LEVEL_DEBUG,
+        LEVEL_INFO,
+        LEVEL_WARNING,
+        LEVEL_ERROR
+    };
+    static Level levelFromName(QString levelName, bool *ok = nullptr);
+    static std::string levelName(Level level);
+
+    // Logger control (process wide, synchronous to terminal while not started)
+    static void startLogger(Level level, bool toTerminal, QString fileName, int rateLimit);
+    static void stopLogger();
+
+    // Records (printf-like message, formatted at the calling thread without allocations)
+    static void debug(const char *module, const char *format, ...) __attribute__((format(printf, 2, 3)));
+    static void info(const char *module, const char *format, ...) __attribute__((format(printf, 2, 3)));
+    static void warning(const char *module, const char *format, ...) __attribute__((format(printf, 2, 3)));
+    static void error(const char *module, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    Logger(Level level, bool toTerminal, QString fileName, int rateLimit);
+
+    // Logger instance (writer thread)
+    static Logger *_instance;
+    static std::atomic<int> _minLevel;
+
+    // Binary record (module is a string literal)
+    struct Record {
+        qint64 timestamp;
+        Level level;
+        const char *module;
+        quint32 suppressed;
+        char message[240];
+    };
+    static void log(Level level, const char *module, const char *format, va_list args);
+
+    // Bounded MPSC queue (producers never block, records are dropped if full)
+    static const quint32 QUEUE_SIZE = 4096;
+    struct Slot {
+        std::atomic<quint64> sequence;
+        Record record;
+    };
+    Slot _slots[QUEUE_SIZE];
+    std::atomic<quint64> _enqueuePosition;
+    quint64 _dequeuePosition;
+    std::atomic<quint64> _dropped;
+    bool push(const Record &record);
+    bool pop(Record *record);
+
+    // Rate limiting (per call site, records per second)
+    static const int RATE_SLOTS = 128;
+    struct RateSlot {
+        std::atomic<qint64> window;
+        std::atomic<int> count;
+        std::atomic<quint32> suppressed;
+    };
+    RateSlot _rateSlots[RATE_SLOTS];
+    int _rateLimit;
+    bool takeRate(const char *format, qint64 timestamp, quint32 *suppressed);
+
+    // Sinks
+    bool _toTerminal;
+    QFile _file;
+    static void writeTerminal(const Record &record);
+    void writeFile(const Record &record);
+
+    // Writer thread
+    void run();
+    std::atomic<bool> _isRunning;
+};
+
+#endif // LOGGER_H
@@ -0,0 +1,194 @@
+#include "metrics.h"
+
+Counter::Counter() {
+    for(int i = 0; i < SHARDS; i++) {
+        _shards[i].value = 0;
+    }
+}
+
+void Counter::increment(quint64 value) {
+    _shards[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+quint64 Counter::value() {
+    // Aggregate shards on read
+    quint64 value = 0;
+    for(int i = 0; i < SHARDS; i++) {
+        value += _shards[i].value.load(std::memory_order_relaxed);
+    }
+
+    return value;
+}
+
+int Counter::shardIndex() {
+    static std::atomic<int> threadsCount(0);
+    static thread_local int shard = (threadsCount++) % SHARDS;
+
+    return shard;
+}
+
+Gauge::Gauge() {
+    _value = 0.0;
+}
+
+void Gauge::set(double value) {
+    _value.store(value, std::memory_order_relaxed);
+}
+
+double Gauge::value() {
+    return _value.load(std::memory_order_relaxed);
+}
+
+Metrics::Metrics(int matchId) {
+    _matchId = matchId;
+}
+
+void Metrics::increment(CounterType type, quint64 value) {
+    _counters[type].increment(value);
+}
+
+void Metrics::incrementObjectLoss(VSSRef::Color teamColor, quint8 playerId) {
+    if(teamColor > VSSRef::Color::YELLOW || playerId >= MAX_PLAYERS) {
+        return ;
+    }
+
+    _objectLosses[teamColor][playerId].increment();
+}
+
+void Metrics::incrementBallLoss() {
+    _ballLosses.increment();
+}
+
+void Metrics::incrementFoul(VSSRef::Foul foul) {
+    _fouls[foul].increment();
+}
+
+void Metrics::incrementPlacement(VSSRef::Color teamColor) {
+    if(teamColor > VSSRef::Color::YELLOW) {
+        return ;
+    }
+
+    _placements[teamColor].increment();
+}
+
+void Metrics::setEntityName(int entityType, const std::string &entityName) {
+    if(entityType < 0 || entityType >= MAX_ENTITIES) {
+        return ;
+    }
+
+    _entityNames[entityType] = entityName;
+}
+
+void Metrics::incrementLoopOverrun(int entityType) {
+    if(entityType < 0 || entityType >= MAX_ENTITIES) {
+        return ;
+    }
+
+    _loopOverruns[entityType].increment();
+}
+
+void Metrics::setLoopTime(int entityType, double seconds) {
+    if(entityType < 0 || entityType >= MAX_ENTITIES) {
+        return ;
+    }
+
+    _loopTimes[entityType].set(seconds);
+}
+
+std::string Metrics::exposition() {
+    std::string out;
+    std::string matchLabel = "match=\"" + std::to_string(_matchId) + "\"";
+
+    // Module counters
+    for(int i = 0; i < COUNTER_COUNT; i++) {
+        writeHeader(&out, counterName(CounterType(i)), counterHelp(CounterType(i)), "counter");
+        writeSample(&out, counterName(CounterType(i)), matchLabel, std::to_string(_counters[i].value()));
+    }
+
+    // Object losses
+    writeHeader(&out, "vssreferee_vision_object_losses_total", "Times a tracked object was lost by Vision.", "counter");
+    writeSample(&out, "vssreferee_vision_object_losses_total", matchLabel + ",object=\"ball\"", std::to_string(_ballLosses.value()));
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < MAX_PLAYERS; j++) {
+            quint64 losses = _objectLosses[i][j].value();
+            if(losses > 0) {
+                writeSample(&out, "vssreferee_vision_object_losses_total", matchLabel + ",object=\"" + VSSRef::Color_Name(VSSRef::Color(i)) + "_" + std::to_string(j) + "\"", std::to_string(losses));
+            }
+        }
+    }
+
+    // Fouls by type
+    writeHeader(&out, "vssreferee_referee_fouls_total", "Fouls detected by the checkers, by type.", "counter");
+    for(int i = VSSRef::Foul_MIN; i <= VSSRef::Foul_MAX; i++) {
+        if(VSSRef::Foul_IsValid(i)) {
+            writeSample(&out, "vssreferee_referee_fouls_total", matchLabel + ",foul=\"" + VSSRef::Foul_Name(VSSRef::Foul(i)) + "\"", std::to_string(_fouls[i].value()));
+        }
+    }
+
+    // Team placements
+    writeHeader(&out, "vssreferee_replacer_placements_received_total", "Placement packets received from the teams.", "counter");
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        writeSample(&out, "vssreferee_replacer_placements_received_total", matchLabel + ",team=\"" + VSSRef::Color_Name(VSSRef::Color(i)) + "\"", std::to_string(_placements[i].value()));
+    }
+
+    // Entities loops
+    writeHeader(&out, "vssreferee_entity_loop_overruns_total", "Loops that took longer than the entity loop period.", "counter");
+    for(int i = 0; i < MAX_ENTITIES; i++) {
+        if(!_entityNames[i].empty()) {
+            writeSample(&out, "vssreferee_entity_loop_overruns_total", matchLabel + ",entity=\"" + _entityNames[i] + "\"", std::to_string(_loopOverruns[i].value()));
+        }
+    }
+    writeHeader(&out, "vssreferee_entity_loop_seconds", "Duration of the last entity loop.", "gauge");
+    for(int i = 0; i < MAX_ENTITIES; i++) {
+        if(!_entityNames[i].empty()) {
+            writeSample(&out, "vssreferee_entity_loop_seconds", matchLabel + ",entity=\"" + _entityNames[i] + "\"", std::to_string(_loopTimes[i].value()));
+        }
+    }
+
+    return out;
+}
+
+std::string Metrics::counterName(CounterType type) {
+    switch(type) {
+        case VISION_DATAGRAMS_RECEIVED: return "vssreferee_vision_datagrams_received_total";
+        case VISION_PARSE_ERRORS: return "vssreferee_vision_parse_errors_total";
+        case VISION_FRAMES_COALESCED: return "vssreferee_vision_frames_coalesced_total";
+        case REFEREE_COMMANDS_SENT: return "vssreferee_referee_commands_sent_total";
+        case REFEREE_HEARTBEATS_SENT: return "vssreferee_referee_heartbeats_sent_total";
+        case REFEREE_TRANSITION_SAVED_MS: return "vssreferee_referee_transition_saved_milliseconds_total";
+        case REPLACER_PACKETS_SENT: return "vssreferee_replacer_packets_sent_total";
+        case REPLACER_PARSE_ERRORS: return "vssreferee_replacer_parse_errors_total";
+        case REPLACER_PLACEMENTS_DROPPED: return "vssreferee_replacer_placements_dropped_total";
+        case BROADCAST_FRAMES_SENT: return "vssreferee_broadcast_frames_sent_total";
+        case BROADCAST_BYTES_SENT: return "vssreferee_broadcast_bytes_sent_total";
+        case REACTOR_WAKEUPS: return "vssreferee_reactor_wakeups_total";
+        default: return "vssreferee_unknown_total";
+    }
+}
+
+std::string Metrics::counterHelp(CounterType type) {
+    switch(type) {
+        case VISION_DATAGRAMS_RECEIVED: return "Datagrams received by Vision.";
+        case VISION_PARSE_ERRORS: return "Vision datagrams that could not be parsed.";
+        case VISION_FRAMES_COALESCED: return "Frames received in the same Vision loop as a newer one.";
+        case REFEREE_COMMANDS_SENT: return "Commands sent by the Referee.";
+        case REFEREE_HEARTBEATS_SENT: return "Repeated sends of the last command by the Referee.";
+        case REFEREE_TRANSITION_SAVED_MS: return "Transition time saved by advancing when robots settled.";
+        case REPLACER_PACKETS_SENT: return "Replacement packets sent by the Replacer.";
+        case REPLACER_PARSE_ERRORS: return "Placement datagrams that could not be parsed.";
+        case REPLACER_PLACEMENTS_DROPPED: return "Placement packets dropped (superseded at the same foul, late, stale or invalid).";
+        case BROADCAST_FRAMES_SENT: return "World state frames sent by the Broadcast.";
+        case BROADCAST_BYTES_SENT: return "World state bytes sent by the Broadcast.";
+        case REACTOR_WAKEUPS: return "Entities woken by the Reactor on datagram arrival.";
+        default: return "";
+    }
+}
+
+void Metrics::writeHeader(std::string *out, const std::string &name, const std::string &help, const std::string &type) {
+    *out += "# HELP " + name + " " + help + "\n";
+    *out += "# TYPE " + name + " " + type + "\n";
+}
+
+void Metrics::writeSample(std::string *out, const std::string &name, const std::string &labels, const std::string &value) {
+    *out += name + "{" + labels + "} " + value + "\n";
+}
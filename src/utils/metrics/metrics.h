@@ -0,0 +1,105 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <string>
+
+#include <include/vssref_common.pb.h>
+
+// Counter sharded by thread (increments never share a cache line between threads)
+class Counter
+{
+public:
+    Counter();
+
+    void increment(quint64 value = 1);
+    quint64 value();
+
+private:
+    static const int SHARDS = 16;
+    struct Shard {
+        std::atomic<quint64> value;
+        char padding[64 - sizeof(std::atomic<quint64>)];
+    };
+    Shard _shards[SHARDS];
+    static int shardIndex();
+};
+
+// Gauge (last value set)
+class Gauge
+{
+public:
+    Gauge();
+
+    void set(double value);
+    double value();
+
+private:
+    std::atomic<double> _value;
+};
+
+class Metrics
+{
+public:
+    Metrics(int matchId);
+
+    // Module counters
+    enum CounterType {
+        VISION_DATAGRAMS_RECEIVED,
+        VISION_PARSE_ERRORS,
+        VISION_FRAMES_COALESCED,
+        REFEREE_COMMANDS_SENT,
+        REFEREE_HEARTBEATS_SENT,
+        REFEREE_TRANSITION_SAVED_MS,
+        REPLACER_PACKETS_SENT,
+        REPLACER_PARSE_ERRORS,
+        REPLACER_PLACEMENTS_DROPPED,
+        BROADCAST_FRAMES_SENT,
+        BROADCAST_BYTES_SENT,
+        REACTOR_WAKEUPS,
+        COUNTER_COUNT
+    };
+    void increment(CounterType type, quint64 value = 1);
+
+    // Labeled counters
+    void incrementObjectLoss(VSSRef::Color teamColor, quint8 playerId);
+    void incrementBallLoss();
+    void incrementFoul(VSSRef::Foul foul);
+    void incrementPlacement(VSSRef::Color teamColor);
+
+    // Entities (indexed by entity type)
+    void setEntityName(int entityType, const std::string &entityName);
+    void incrementLoopOverrun(int entityType);
+    void setLoopTime(int entityType, double seconds);
+
+    // Prometheus text exposition
+    std::string exposition();
+
+private:
+    // Match info (label of all series)
+    int _matchId;
+
+    // Counters
+    Counter _counters[COUNTER_COUNT];
+    static std::string counterName(CounterType type);
+    static std::string counterHelp(CounterType type);
+
+    // Labeled counters
+    static const int MAX_PLAYERS = 16;
+    static const int MAX_ENTITIES = 8;
+    Counter _objectLosses[2][MAX_PLAYERS];
+    Counter _ballLosses;
+    Counter _fouls[VSSRef::Foul_ARRAYSIZE];
+    Counter _placements[2];
+    Counter _loopOverruns[MAX_ENTITIES];
+    Gauge _loopTimes[MAX_ENTITIES];
+    std::string _entityNames[MAX_ENTITIES];
+
+    // Exposition helpers
+    void writeHeader(std::string *out, const std::string &name, const std::string &help, const std::string &type);
+    void writeSample(std::string *out, const std::string &name, const std::string &labels, const std::string &value);
+};
+
+#endif // METRICS_H
@@ -0,0 +1,156 @@
+#include "scheduling.h"
+
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <src/utils/logger/logger.h>
+
+Scheduling::Scheduling() {
+    _loopFrequency = 0;
+    _niceValue = 0;
+    _policy = POLICY_OTHER;
+    _realtimePriority = 0;
+}
+
+Scheduling::Scheduling(const QVariantMap &schedulingMap) {
+    _loopFrequency = schedulingMap["loopFrequency"].toInt();
+    _niceValue = schedulingMap["nice"].toInt();
+    _realtimePriority = schedulingMap["realtimePriority"].toInt();
+
+    // Taking CPUs
+    QVariantList cpus = schedulingMap["cpus"].toList();
+    for(int i = 0; i < cpus.size(); i++) {
+        _cpus.push_back(cpus.at(i).toInt());
+    }
+
+    // Taking policy
+    QString policy = schedulingMap["policy"].toString().toLower();
+    if(policy == "fifo") {
+        _policy = POLICY_FIFO;
+    }
+    else if(policy == "rr") {
+        _policy = POLICY_RR;
+    }
+    else {
+        _policy = POLICY_OTHER;
+    }
+}
+
+std::string Scheduling::policyName(Policy policy) {
+    switch(policy) {
+        case POLICY_OTHER: return "other";
+        case POLICY_FIFO: return "fifo";
+        case POLICY_RR: return "rr";
+        default: return "unknown";
+    }
+}
+
+int Scheduling::loopFrequency() const {
+    return _loopFrequency;
+}
+
+QList<int> Scheduling::cpus() const {
+    return _cpus;
+}
+
+int Scheduling::niceValue() const {
+    return _niceValue;
+}
+
+Scheduling::Policy Scheduling::policy() const {
+    return _policy;
+}
+
+int Scheduling::realtimePriority() const {
+    return _realtimePriority;
+}
+
+std::string Scheduling::toString() const {
+    std::string cpus;
+    for(int i = 0; i < _cpus.size(); i++) {
+        cpus += ((i > 0) ? "," : "") + std::to_string(_cpus.at(i));
+    }
+
+    return "loopFrequency " + ((_loopFrequency > 0) ? std::to_string(_loopFrequency) : std::string("default")) + ", cpus [" + cpus + "], policy " + policyName(_policy) + ((_policy == POLICY_OTHER) ? ", nice " + std::to_string(_niceValue) : ", priority " + std::to_string(_realtimePriority));
+}
+
+bool Scheduling::applyToCurrentThread(const std::string &threadName) const {
+#ifdef Q_OS_LINUX
+    bool isApplied = true;
+
+    // CPU affinity
+    if(!_cpus.isEmpty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for(int i = 0; i < _cpus.size(); i++) {
+            if(_cpus.at(i) >= 0 && _cpus.at(i) < CPU_SETSIZE) {
+                CPU_SET(_cpus.at(i), &cpuSet);
+            }
+        }
+
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if(error != 0) {
+            Logger::warning("SCHEDULING", "Could not set CPUs of %s: %s.", threadName.c_str(), strerror(error));
+            isApplied = false;
+        }
+    }
+
+    // Real-time policy (needs CAP_SYS_NICE or RLIMIT_RTPRIO)
+    bool isRealtime = false;
+    if(_policy != POLICY_OTHER) {
+        int policy = (_policy == POLICY_FIFO) ? SCHED_FIFO : SCHED_RR;
+
+        sched_param param;
+        param.sched_priority = qBound(sched_get_priority_min(policy), _realtimePriority, sched_get_priority_max(policy));
+
+        int error = pthread_setschedparam(pthread_self(), policy, &param);
+        if(error == 0) {
+            isRealtime = true;
+        }
+        else {
+            Logger::warning("SCHEDULING", "Could not set %s policy of %s (%s), falling back to nice %d.", policyName(_policy).c_str(), threadName.c_str(), strerror(error), _niceValue);
+            isApplied = false;
+        }
+    }
+
+    // Nice value (per thread at Linux, negative values need CAP_SYS_NICE)
+    if(!isRealtime && _niceValue != 0) {
+        if(setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), _niceValue) != 0) {
+            Logger::warning("SCHEDULING", "Could not set nice %d of %s: %s.", _niceValue, threadName.c_str(), strerror(errno));
+            isApplied = false;
+        }
+    }
+
+    return isApplied;
+#else
+    if(!_cpus.isEmpty() || _policy != POLICY_OTHER || _niceValue != 0) {
+        Logger::warning("SCHEDULING", "Thread scheduling of %s is not supported at this platform.", threadName.c_str());
+    }
+
+    return false;
+#endif
+}
+
+bool Scheduling::lockMemory() {
+#ifdef Q_OS_LINUX
+    if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        Logger::warning("SCHEDULING", "Could not lock memory: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+#else
+    Logger::warning("SCHEDULING", "Memory locking is not supported at this platform.");
+    return false;
+#endif
+}
@@ -0,0 +1,46 @@
+#ifndef SCHEDULING_H
+#define SCHEDULING_H
+
+#include <QVariantMap>
+#include <QList>
+
+#include <string>
+
+// Scheduling of an entity thread (loop frequency, CPUs, nice value or real-time policy)
+class Scheduling
+{
+public:
+    Scheduling();
+    Scheduling(const QVariantMap &schedulingMap);
+
+    // Policies
+    enum Policy {
+        POLICY_OTHER,
+        POLICY_FIFO,
+        POLICY_RR
+    };
+    static std::string policyName(Policy policy);
+
+    // Getters (loop frequency is 0 if not configured)
+    int loopFrequency() const;
+    QList<int> cpus() const;
+    int niceValue() const;
+    Policy policy() const;
+    int realtimePriority() const;
+    std::string toString() const;
+
+    // Apply to the calling thread (falls back to nice value if the real-time policy is not permitted)
+    bool applyToCurrentThread(const std::string &threadName) const;
+
+    // Lock process memory (current and future pages)
+    static bool lockMemory();
+
+private:
+    int _loopFrequency;
+    QList<int> _cpus;
+    int _niceValue;
+    Policy _policy;
+    int _realtimePriority;
+};
+
+#endif // SCHEDULING_H
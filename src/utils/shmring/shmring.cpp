@@ -0,0 +1,240 @@
+#include "shmring.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <src/utils/logger/logger.h>
+
+ShmRing::ShmRing() {
+    // Not opened
+    _isProducer = false;
+    _fd = -1;
+    _memory = nullptr;
+    _memorySize = 0;
+    _header = nullptr;
+
+    // Init positions
+    _writePosition = 0;
+    _readPosition = 0;
+    _peekSequence = 0;
+    _overruns = 0;
+}
+
+ShmRing::~ShmRing() {
+    close();
+}
+
+bool ShmRing::create(const std::string &name, PayloadType payloadType, quint32 slotsCount, quint32 slotSize) {
+    close();
+
+    // At least two slots (one is read while the next is written)
+    slotsCount = std::max(slotsCount, 2u);
+
+    // Slots are aligned to cache lines
+    quint32 slotStride = ((sizeof(SlotHeader) + slotSize + 63) / 64) * 64;
+    size_t memorySize = sizeof(Header) + static_cast<size_t>(slotStride) * slotsCount;
+
+    // Create shared memory (a ring left by a finished producer is reused)
+    _fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if(_fd == -1 || ftruncate(_fd, memorySize) == -1 || !map(memorySize, true)) {
+        Logger::error("SHMRING", "Error while creating ring '%s': %s", name.c_str(), strerror(errno));
+        close();
+        return false;
+    }
+    _name = name;
+    _isProducer = true;
+
+    // Fill header (consumers attach only after magic is set)
+    _header->magic.store(0, std::memory_order_relaxed);
+    _header->version = VERSION;
+    _header->payloadType = payloadType;
+    _header->slotsCount = slotsCount;
+    _header->slotSize = slotSize;
+    _header->slotStride = slotStride;
+    _header->isClosed.store(0, std::memory_order_relaxed);
+    _header->writePosition.store(0, std::memory_order_relaxed);
+    for(quint32 i = 0; i < slotsCount; i++) {
+        slotAt(i)->sequence.store(0, std::memory_order_relaxed);
+        slotAt(i)->size = 0;
+    }
+    _header->magic.store(MAGIC, std::memory_order_release);
+    _writePosition = 0;
+
+    return true;
+}
+
+char* ShmRing::beginWrite() {
+    // Mark slot as being written (consumers reading it discard it)
+    SlotHeader *slot = slotAt(_writePosition);
+    slot->sequence.store(2 * _writePosition + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return payloadOf(slot);
+}
+
+void ShmRing::endWrite(quint32 size) {
+    // Publish slot and position
+    SlotHeader *slot = slotAt(_writePosition);
+    slot->size = std::min(size, _header->slotSize);
+    slot->sequence.store(2 * _writePosition + 2, std::memory_order_release);
+    _header->writePosition.store(++_writePosition, std::memory_order_release);
+}
+
+bool ShmRing::write(const char *data, quint32 size) {
+    if(!_isProducer || size > _header->slotSize) {
+        return false;
+    }
+
+    memcpy(beginWrite(), data, size);
+    endWrite(size);
+
+    return true;
+}
+
+bool ShmRing::attach(const std::string &name, PayloadType payloadType) {
+    close();
+
+    // Open existing shared memory (read only)
+    _fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if(_fd == -1) {
+        return false;
+    }
+
+    // Map header first, then the whole ring
+    struct stat status;
+    if(fstat(_fd, &status) == -1 || static_cast<size_t>(status.st_size) < sizeof(Header) || !map(status.st_size, false)) {
+        close();
+        return false;
+    }
+
+    // Check if producer finished the header and if ring carries the expected payload
+    if(_header->magic.load(std::memory_order_acquire) != MAGIC || _header->isClosed.load(std::memory_order_acquire) != 0 || _header->slotsCount == 0 || _header->version != VERSION || _header->payloadType != static_cast<quint32>(payloadType) || sizeof(Header) + static_cast<size_t>(_header->slotStride) * _header->slotsCount > _memorySize) {
+        close();
+        return false;
+    }
+    _name = name;
+    _isProducer = false;
+
+    // Start at the next slot written
+    _readPosition = _header->writePosition.load(std::memory_order_acquire);
+    _overruns = 0;
+
+    return true;
+}
+
+const char* ShmRing::peek(quint32 *size) {
+    if(_header == nullptr || _isProducer) {
+        return nullptr;
+    }
+
+    quint64 writePosition = _header->writePosition.load(std::memory_order_acquire);
+
+    // Ring was created again by a new producer
+    if(_readPosition > writePosition) {
+        _readPosition = writePosition;
+    }
+
+    // No new slots
+    if(_readPosition == writePosition) {
+        return nullptr;
+    }
+
+    // Consumer was lapped, skip to the last written slot
+    if(writePosition - _readPosition >= _header->slotsCount) {
+        _overruns += writePosition - 1 - _readPosition;
+        _readPosition = writePosition - 1;
+    }
+
+    // Check if slot still holds this position
+    SlotHeader *slot = slotAt(_readPosition);
+    _peekSequence = slot->sequence.load(std::memory_order_acquire);
+    if(_peekSequence != 2 * _readPosition + 2) {
+        _overruns++;
+        _readPosition = writePosition;
+        return nullptr;
+    }
+
+    *size = std::min(slot->size, _header->slotSize);
+
+    return payloadOf(slot);
+}
+
+bool ShmRing::commit() {
+    if(_header == nullptr || _isProducer) {
+        return false;
+    }
+
+    // Check if slot was overwritten while read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    bool isValid = (slotAt(_readPosition)->sequence.load(std::memory_order_relaxed) == _peekSequence);
+    if(!isValid) {
+        _overruns++;
+    }
+    _readPosition++;
+
+    return isValid;
+}
+
+bool ShmRing::isProducerClosed() {
+    return (_header != nullptr && _header->isClosed.load(std::memory_order_acquire) != 0);
+}
+
+quint64 ShmRing::overruns() {
+    return _overruns;
+}
+
+bool ShmRing::isOpen() {
+    return (_header != nullptr);
+}
+
+void ShmRing::close() {
+    // Producer marks ring as closed (consumers attach again) and unlinks it
+    if(_header != nullptr && _isProducer) {
+        _header->isClosed.store(1, std::memory_order_release);
+        shm_unlink(_name.c_str());
+    }
+
+    if(_memory != nullptr) {
+        munmap(_memory, _memorySize);
+    }
+    if(_fd != -1) {
+        ::close(_fd);
+    }
+
+    _isProducer = false;
+    _fd = -1;
+    _memory = nullptr;
+    _memorySize = 0;
+    _header = nullptr;
+}
+
+quint32 ShmRing::slotSize() {
+    return (_header != nullptr) ? _header->slotSize : 0;
+}
+
+ShmRing::SlotHeader* ShmRing::slotAt(quint64 position) {
+    char *slotsMemory = static_cast<char*>(_memory) + sizeof(Header);
+    return reinterpret_cast<SlotHeader*>(slotsMemory + (position % _header->slotsCount) * _header->slotStride);
+}
+
+char* ShmRing::payloadOf(SlotHeader *slot) {
+    return reinterpret_cast<char*>(slot) + sizeof(SlotHeader);
+}
+
+bool ShmRing::map(size_t memorySize, bool isWritable) {
+    _memory = mmap(nullptr, memorySize, isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, _fd, 0);
+    if(_memory == MAP_FAILED) {
+        _memory = nullptr;
+        return false;
+    }
+
+    _memorySize = memorySize;
+    _header = static_cast<Header*>(_memory);
+
+    return true;
+}
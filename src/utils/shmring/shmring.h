@@ -0,0 +1,84 @@
+#ifndef SHMRING_H
+#define SHMRING_H
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <string>
+
+// Ring of fixed size slots in shared memory (/dev/shm), for one producer process and any number of consumers.
+// Each slot is a seqlock: consumers never block the producer, and a slot overwritten while read is discarded.
+class ShmRing
+{
+public:
+    // Slots payload (checked when a consumer attaches)
+    enum PayloadType {
+        PAYLOAD_ENVIRONMENT = 1,    // serialized fira_message::sim_to_ref::Environment
+        PAYLOAD_COMMAND = 2,        // serialized VSSRef::ref_to_team::VSSRef_Command
+        PAYLOAD_VISION_SNAPSHOT = 3 // VisionSnapshot struct
+    };
+
+    ShmRing();
+    ~ShmRing();
+
+    // Producer (creates the ring, it is unlinked when closed)
+    bool create(const std::string &name, PayloadType payloadType, quint32 slotsCount, quint32 slotSize);
+    char* beginWrite();
+    void endWrite(quint32 size);
+    bool write(const char *data, quint32 size);
+
+    // Consumer (attaches to an existing ring, starting at its next slot)
+    bool attach(const std::string &name, PayloadType payloadType);
+    const char* peek(quint32 *size);
+    bool commit();
+    bool isProducerClosed();
+    quint64 overruns();
+
+    // Ring control
+    bool isOpen();
+    void close();
+    quint32 slotSize();
+
+private:
+    // Ring header (first cache lines of the shared memory)
+    static const quint32 MAGIC = 0x56535352; // "VSSR"
+    static const quint32 VERSION = 1;
+    struct Header {
+        std::atomic<quint32> magic;
+        quint32 version;
+        quint32 payloadType;
+        quint32 slotsCount;
+        quint32 slotSize;
+        quint32 slotStride;
+        std::atomic<quint32> isClosed;
+        char padding0[36];
+        std::atomic<quint64> writePosition;
+        char padding1[56];
+    };
+
+    // Slot header (sequence is 2 * position + 1 while written and 2 * position + 2 when done)
+    struct SlotHeader {
+        std::atomic<quint64> sequence;
+        quint32 size;
+        quint32 reserved;
+    };
+
+    // Mapping
+    std::string _name;
+    bool _isProducer;
+    int _fd;
+    void *_memory;
+    size_t _memorySize;
+    Header *_header;
+    SlotHeader* slotAt(quint64 position);
+    char* payloadOf(SlotHeader *slot);
+    bool map(size_t memorySize, bool isWritable);
+
+    // Positions
+    quint64 _writePosition;
+    quint64 _readPosition;
+    quint64 _peekSequence;
+    quint64 _overruns;
+};
+
+#endif // SHMRING_H
@@ -0,0 +1,56 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for one producer thread and one consumer thread
+template<class T, size_t CAPACITY>
+class SpscQueue
+{
+public:
+    SpscQueue() {
+        _head = 0;
+        _tail = 0;
+    }
+
+    // Producer side (returns false if full)
+    bool push(const T &item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if(tail - _head.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+
+        _items[tail % CAPACITY] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side (returns false if empty)
+    bool pop(T *item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if(head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        *item = _items[head % CAPACITY];
+        _head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool isEmpty() {
+        return (_head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire));
+    }
+
+private:
+    // Indexes are kept at different cache lines (written by different threads)
+    std::atomic<size_t> _head;
+    char _headPadding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _tail;
+    char _tailPadding[64 - sizeof(std::atomic<size_t>)];
+    T _items[CAPACITY];
+};
+
+#endif // SPSCQUEUE_H
@@ -24,55 +24,41 @@ std::string Text::bold(std::string s) {
 }
 
 std::string Text::red(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;31m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;31m" + s + "\033[0m";
-    }
+    return color(s, RED, bold);
 }
 
 std::string Text::green(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;32m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;32m" + s + "\033[0m";
-    }
+    return color(s, GREEN, bold);
 }
 
 std::string Text::yellow(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;33m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;33m" + s + "\033[0m";
-    }
+    return color(s, YELLOW, bold);
 }
 
 std::string Text::blue(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;34m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;34m" + s + "\033[0m";
-    }
+    return color(s, BLUE, bold);
 }
 
 std::string Text::purple(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;35m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;35m" + s + "\033[0m";
-    }
+    return color(s, PURPLE, bold);
 }
 
 std::string Text::cyan(std::string s, bool bold) {
-    if(bold) {
-        return "\033[1;36m" + s + "\033[0m";
-    }
-    else {
-        return "\033[0;36m" + s + "\033[0m";
+    return color(s, CYAN, bold);
+}
+
+std::string Text::color(std::string s, Color color, bool bold) {
+    // Default color only takes the weight
+    if(color == DEFAULT) {
+        return (bold) ? Text::bold(s) : s;
     }
+
+    // ANSI color codes (31 to 36)
+    int code = 30 + static_cast<int>(color);
+
+    return "\033[" + std::string(bold ? "1" : "0") + ";" + std::to_string(code) + "m" + s + "\033[0m";
+}
+
+std::string Text::record(const std::string &module, const std::string &message, Color messageColor, bool boldMessage) {
+    return blue("[" + module + "] ", true) + color(message, messageColor, boldMessage) + '\n';
 }
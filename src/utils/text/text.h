@@ -8,6 +8,17 @@ class Text
 public:
     Text();
 
+    // Terminal colors
+    enum Color {
+        DEFAULT,
+        RED,
+        GREEN,
+        YELLOW,
+        BLUE,
+        PURPLE,
+        CYAN
+    };
+
     static std::string center(std::string s);
     static std::string bold(std::string s);
     static std::string red(std::string s, bool bold = false);
@@ -16,6 +27,10 @@ public:
     static std::string blue(std::string s, bool bold = false);
     static std::string purple(std::string s, bool bold = false);
     static std::string cyan(std::string s, bool bold = false);
+    static std::string color(std::string s, Color color, bool bold = false);
+
+    // Sink formatter (terminal records of the logger)
+    static std::string record(const std::string &module, const std::string &message, Color messageColor, bool boldMessage);
 };
 
 #endif // TEXT_H
@@ -1,19 +1,26 @@
 #include "timer.h"
 
-Timer::Timer() {
+Timer::Timer(Clock *clock) {
+    // Taking clock
+    _clock = clock;
+
     // Updating time1 and time2 with actual time
-    _time1 = std::chrono::high_resolution_clock::now();
-    _time2 = std::chrono::high_resolution_clock::now();
+    _time1 = now();
+    _time2 = now();
 }
 
 void Timer::start() {
     // Updating time1 with last time
-    _time1 = std::chrono::high_resolution_clock::now();
+    _time1 = now();
 }
 
 void Timer::stop() {
     // Updating time2 with last time
-    _time2 = std::chrono::high_resolution_clock::now();
+    _time2 = now();
+}
+
+void Timer::setClock(Clock *clock) {
+    _clock = clock;
 }
 
 double Timer::getSeconds() {
@@ -32,3 +39,11 @@ double Timer::getNanoSeconds() {
     auto passedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(_time2 - _time1);
     return (passedTime.count());
 }
+
+std::chrono::high_resolution_clock::time_point Timer::now() {
+    if(_clock != nullptr) {
+        return _clock->now();
+    }
+
+    return std::chrono::high_resolution_clock::now();
+}
@@ -3,15 +3,20 @@
 
 #include <chrono>
 
+#include <src/utils/clock/clock.h>
+
 class Timer
 {
 public:
-    Timer();
+    Timer(Clock *clock = nullptr);
 
     // Timer control
     void start();
     void stop();
 
+    // Clock (nullptr uses the system clock)
+    void setClock(Clock *clock);
+
     // Getters
     double getSeconds();
     double getMiliSeconds();
@@ -24,6 +29,10 @@ private:
 
     std::chrono::high_resolution_clock::time_point _time1;
     std::chrono::high_resolution_clock::time_point _time2;
+
+    // Time source
+    Clock *_clock;
+    std::chrono::high_resolution_clock::time_point now();
 };
 
 #endif // TIMER_H
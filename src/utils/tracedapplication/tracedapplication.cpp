@@ -0,0 +1,21 @@
+#include "tracedapplication.h"
+
+#include <QEvent>
+
+#include <src/utils/tracer/tracer.h>
+
+TracedApplication::TracedApplication(int &argc, char **argv) : QApplication(argc, argv) {
+
+}
+
+bool TracedApplication::notify(QObject *receiver, QEvent *event) {
+    if(!Tracer::isEnabled() || event->type() != QEvent::MetaCall) {
+        return QApplication::notify(receiver, event);
+    }
+
+    // Span for the slot called by the queued signal
+    TraceSpan deliverySpan("deliver", "signal");
+    deliverySpan.setName(QString("deliver:") + receiver->metaObject()->className());
+
+    return QApplication::notify(receiver, event);
+}
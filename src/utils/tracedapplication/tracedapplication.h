@@ -0,0 +1,15 @@
+#ifndef TRACEDAPPLICATION_H
+#define TRACEDAPPLICATION_H
+
+#include <QApplication>
+
+class TracedApplication : public QApplication
+{
+public:
+    TracedApplication(int &argc, char **argv);
+
+    // Traces queued signal deliveries (cross-thread slots run here)
+    bool notify(QObject *receiver, QEvent *event);
+};
+
+#endif // TRACEDAPPLICATION_H
@@ -0,0 +1,287 @@
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include <chrono>
+#include <cstring>
+
+#include <src/utils/text/text.h>
+
+// Event taken by an entity (fixed size, copied into the ring)
+struct TraceEvent {
+    char name[64];
+    const char *category;
+    char phase;
+    qint64 timestamp;
+    qint64 duration;
+};
+
+// Single producer (owner thread) and single consumer (writer thread) ring
+class TraceBuffer
+{
+public:
+    TraceBuffer(int threadId) {
+        _threadId = threadId;
+        _head = 0;
+        _tail = 0;
+        _dropped = 0;
+    }
+
+    bool push(const TraceEvent &event) {
+        quint32 head = _head.load(std::memory_order_relaxed);
+        quint32 next = (head + 1) % CAPACITY;
+
+        // Full buffer, drop event
+        if(next == _tail.load(std::memory_order_acquire)) {
+            _dropped++;
+            return false;
+        }
+
+        _events[head] = event;
+        _head.store(next, std::memory_order_release);
+
+        return true;
+    }
+
+    bool pop(TraceEvent *event) {
+        quint32 tail = _tail.load(std::memory_order_relaxed);
+
+        // Empty buffer
+        if(tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        *event = _events[tail];
+        _tail.store((tail + 1) % CAPACITY, std::memory_order_release);
+
+        return true;
+    }
+
+    int threadId() { return _threadId; }
+    quint64 dropped() { return _dropped.load(); }
+
+private:
+    static const quint32 CAPACITY = 8192;
+    TraceEvent _events[CAPACITY];
+    std::atomic<quint32> _head;
+    std::atomic<quint32> _tail;
+    std::atomic<quint64> _dropped;
+    int _threadId;
+};
+
+Tracer* Tracer::_instance = nullptr;
+std::atomic<bool> Tracer::_isEnabled(false);
+std::atomic<int> Tracer::_generation(0);
+
+Tracer::Tracer(QString fileName) {
+    _file.setFileName(fileName);
+    _isRunning = true;
+    _isFirstEvent = true;
+    _writtenEvents = 0;
+    _pid = QCoreApplication::applicationPid();
+}
+
+Tracer::~Tracer() {
+    // Deleting buffers
+    for(int i = 0; i < _buffers.size(); i++) {
+        delete _buffers.at(i);
+    }
+}
+
+void Tracer::startTracing(QString fileName) {
+    if(_instance != nullptr) {
+        return ;
+    }
+
+    // Open trace file and write header
+    Tracer *tracer = new Tracer(fileName);
+    if(!tracer->_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::cout << Text::blue("[TRACER] ", true) << Text::red("Error while opening '" + fileName.toStdString() + "'.", true) + '\n';
+        delete tracer;
+        return ;
+    }
+    tracer->_file.write("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+    // Start writer and enable events
+    _instance = tracer;
+    _instance->start();
+    _isEnabled = true;
+
+    std::cout << Text::blue("[TRACER] ", true) + Text::bold("Tracing to '" + fileName.toStdString() + "'.") + '\n';
+}
+
+void Tracer::stopTracing() {
+    if(_instance == nullptr) {
+        return ;
+    }
+
+    // Disable events and wait writer to finish
+    _isEnabled = false;
+    _instance->_isRunning = false;
+    _instance->wait();
+
+    // Buffers of running threads are registered again in a next start
+    _generation++;
+
+    delete _instance;
+    _instance = nullptr;
+}
+
+void Tracer::setThreadName(const std::string &threadName) {
+    if(!isEnabled()) {
+        return ;
+    }
+
+    // Thread name goes as a metadata event
+    push('M', threadName.c_str(), "__metadata", now(), 0);
+}
+
+void Tracer::complete(const char *name, const char *category, qint64 startTime, qint64 duration) {
+    push('X', name, category, startTime, duration);
+}
+
+void Tracer::instant(const char *name, const char *category) {
+    if(!isEnabled()) {
+        return ;
+    }
+
+    push('i', name, category, now(), 0);
+}
+
+qint64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TraceBuffer* Tracer::threadBuffer() {
+    static thread_local TraceBuffer *buffer = nullptr;
+    static thread_local int bufferGeneration = -1;
+
+    if(_instance == nullptr) {
+        return nullptr;
+    }
+
+    // Register a buffer for this thread (once per start)
+    if(buffer == nullptr || bufferGeneration != _generation.load()) {
+        _instance->_buffersMutex.lock();
+        buffer = new TraceBuffer(_instance->_buffers.size() + 1);
+        _instance->_buffers.push_back(buffer);
+        _instance->_buffersMutex.unlock();
+
+        bufferGeneration = _generation.load();
+    }
+
+    return buffer;
+}
+
+void Tracer::push(char phase, const char *name, const char *category, qint64 timestamp, qint64 duration) {
+    if(!isEnabled()) {
+        return ;
+    }
+
+    TraceEvent event;
+    strncpy(event.name, name, sizeof(event.name) - 1);
+    event.name[sizeof(event.name) - 1] = '\0';
+    event.category = category;
+    event.phase = phase;
+    event.timestamp = timestamp;
+    event.duration = duration;
+
+    TraceBuffer *buffer = threadBuffer();
+    if(buffer != nullptr) {
+        buffer->push(event);
+    }
+}
+
+void Tracer::run() {
+    while(_isRunning) {
+        flush();
+        msleep(50);
+    }
+
+    // Last flush and close trace
+    flush();
+    _file.write("\n]}\n");
+    _file.close();
+
+    // Count dropped events
+    quint64 droppedEvents = 0;
+    _buffersMutex.lock();
+    for(int i = 0; i < _buffers.size(); i++) {
+        droppedEvents += _buffers.at(i)->dropped();
+    }
+    _buffersMutex.unlock();
+
+    std::cout << Text::blue("[TRACER] ", true) + Text::bold("Written " + std::to_string(_writtenEvents) + " events (" + std::to_string(droppedEvents) + " dropped).") + '\n';
+}
+
+void Tracer::flush() {
+    // Take registered buffers
+    _buffersMutex.lock();
+    QList<TraceBuffer*> buffers = _buffers;
+    _buffersMutex.unlock();
+
+    QTextStream stream(&_file);
+    for(int i = 0; i < buffers.size(); i++) {
+        TraceBuffer *buffer = buffers.at(i);
+        TraceEvent event;
+
+        while(buffer->pop(&event)) {
+            if(!_isFirstEvent) {
+                stream << ",\n";
+            }
+            _isFirstEvent = false;
+
+            // Chrome trace event format (timestamps in us)
+            if(event.phase == 'M') {
+                stream << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << _pid << ", \"tid\": " << buffer->threadId() << ", \"args\": {\"name\": \"" << event.name << "\"}}";
+            }
+            else {
+                stream << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category << "\", \"ph\": \"" << ((event.phase == 'X') ? "X" : "i") << "\", \"ts\": " << QString::number(event.timestamp / 1E3, 'f', 3) << ", ";
+                if(event.phase == 'X') {
+                    stream << "\"dur\": " << QString::number(event.duration / 1E3, 'f', 3) << ", ";
+                }
+                else {
+                    stream << "\"s\": \"t\", ";
+                }
+                stream << "\"pid\": " << _pid << ", \"tid\": " << buffer->threadId() << "}";
+            }
+
+            _writtenEvents++;
+        }
+    }
+    stream.flush();
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category) {
+    _isActive = Tracer::isEnabled();
+    _category = category;
+
+    if(_isActive) {
+        strncpy(_name, name, sizeof(_name) - 1);
+        _name[sizeof(_name) - 1] = '\0';
+        _startTime = Tracer::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    finish();
+}
+
+void TraceSpan::finish() {
+    if(_isActive) {
+        Tracer::complete(_name, _category, _startTime, Tracer::now() - _startTime);
+        _isActive = false;
+    }
+}
+
+bool TraceSpan::isActive() {
+    return _isActive;
+}
+
+void TraceSpan::setName(const QString &name) {
+    if(_isActive) {
+        strncpy(_name, name.toStdString().c_str(), sizeof(_name) - 1);
+        _name[sizeof(_name) - 1] = '\0';
+    }
+}
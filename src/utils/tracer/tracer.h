@@ -0,0 +1,74 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QFile>
+#include <QList>
+
+#include <atomic>
+
+// Thread-local ring buffer with the events of a single thread
+class TraceBuffer;
+
+class Tracer : public QThread
+{
+public:
+    // Tracer control (opt-in, process wide)
+    static void startTracing(QString fileName);
+    static void stopTracing();
+    static bool isEnabled() { return _isEnabled.load(std::memory_order_relaxed); }
+
+    // Events (taken at the calling thread)
+    static void setThreadName(const std::string &threadName);
+    static void complete(const char *name, const char *category, qint64 startTime, qint64 duration);
+    static void instant(const char *name, const char *category);
+    static qint64 now();
+
+private:
+    Tracer(QString fileName);
+    ~Tracer();
+
+    // Tracer instance (writer thread)
+    static Tracer *_instance;
+    static std::atomic<bool> _isEnabled;
+    static std::atomic<int> _generation;
+
+    // Buffers management
+    QList<TraceBuffer*> _buffers;
+    QMutex _buffersMutex;
+    static TraceBuffer* threadBuffer();
+    static void push(char phase, const char *name, const char *category, qint64 timestamp, qint64 duration);
+
+    // Writer thread (flushes buffers to file in chrome trace format)
+    void run();
+    void flush();
+    QFile _file;
+    std::atomic<bool> _isRunning;
+    bool _isFirstEvent;
+    quint64 _writtenEvents;
+    qint64 _pid;
+};
+
+// Span of a scope, recorded as a complete event when destroyed
+class TraceSpan
+{
+public:
+    TraceSpan(const char *name, const char *category);
+    ~TraceSpan();
+
+    // Span info
+    bool isActive();
+    void setName(const QString &name);
+
+    // Record span before leaving the scope
+    void finish();
+
+private:
+    bool _isActive;
+    qint64 _startTime;
+    const char *_category;
+    char _name[64];
+};
+
+#endif // TRACER_H
@@ -1,6 +1,6 @@
 #include "object.h"
 
-Object::Object(bool useKalman) {
+Object::Object(bool useKalman, int noiseTime, int lossTime, Clock *clock) : _lossFilter(lossTime, clock), _noiseFilter(noiseTime, clock), _kalmanFilter(clock) {
     _useKalman = useKalman;
     setInvalid();
 }
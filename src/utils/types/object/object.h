@@ -9,7 +9,7 @@
 class Object
 {
 public:
-    Object(bool useKalman);
+    Object(bool useKalman, int noiseTime, int lossTime, Clock *clock = nullptr);
     ~Object();
 
     // Getters
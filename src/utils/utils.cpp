@@ -1,8 +1,6 @@
 #include "utils.h"
 #include <math.h>
 
-Constants* Utils::_constants = nullptr;
-
 float Utils::distance(const Position &a, const Position &b) {
     return sqrt(pow(a.x() - b.x() ,2) + pow(a.y() - b.y(), 2));
 }
@@ -82,12 +80,12 @@ float Utils::distanceToSegment(const Position &s1, const Position &s2, const Pos
     }
 }
 
-bool Utils::isInsideGoalArea(VSSRef::Color teamColor, Position pos){
+bool Utils::isInsideGoalArea(VSSRef::Color teamColor, Position pos, Constants *constants){
     float goal_x = (Field_Default_3v3::kFieldLength/2.0 - Field_Default_3v3::kDefenseRadius) / 1000.0;
     float goal_y = (Field_Default_3v3::kDefenseStretch / 2.0) / 1000.0;
 
     if(teamColor == VSSRef::Color::BLUE){
-        if(getConstants()->blueIsLeftSide()){
+        if(constants->blueIsLeftSide()){
             if(pos.x() < -goal_x && abs(pos.y()) < goal_y)
                 return true;
         }
@@ -97,7 +95,7 @@ bool Utils::isInsideGoalArea(VSSRef::Color teamColor, Position pos){
         }
     }
     else if(teamColor == VSSRef::Color::YELLOW){
-        if(getConstants()->blueIsLeftSide()){
+        if(constants->blueIsLeftSide()){
             if(pos.x() > goal_x && abs(pos.y()) < goal_y)
                 return true;
         }
@@ -110,12 +108,12 @@ bool Utils::isInsideGoalArea(VSSRef::Color teamColor, Position pos){
     return false;
 }
 
-bool Utils::isBallInsideGoal(VSSRef::Color teamColor, Position pos) {
-    float goal_x = (Field_Default_3v3::kFieldLength/2.0) / 1000.0 + getConstants()->ballRadius();
+bool Utils::isBallInsideGoal(VSSRef::Color teamColor, Position pos, Constants *constants) {
+    float goal_x = (Field_Default_3v3::kFieldLength/2.0) / 1000.0 + constants->ballRadius();
     float goal_y = (Field_Default_3v3::kDefenseStretch / 2.0) / 1000.0;
 
     if(teamColor == VSSRef::Color::BLUE){
-        if(getConstants()->blueIsLeftSide()){
+        if(constants->blueIsLeftSide()){
             if(pos.x() < -goal_x && abs(pos.y()) < goal_y)
                 return true;
         }
@@ -125,7 +123,7 @@ bool Utils::isBallInsideGoal(VSSRef::Color teamColor, Position pos) {
         }
     }
     else if(teamColor == VSSRef::Color::YELLOW){
-        if(getConstants()->blueIsLeftSide()){
+        if(constants->blueIsLeftSide()){
             if(pos.x() > goal_x && abs(pos.y()) < goal_y)
                 return true;
         }
@@ -163,19 +161,3 @@ VSSRef::Quadrant Utils::getBallQuadrant(Position ballPos){
 
     return VSSRef::Quadrant::NO_QUADRANT;
 }
-
-void Utils::setConstants(Constants *constants){
-    _constants = constants;
-}
-
-Constants* Utils::getConstants() {
-    if(_constants == nullptr) {
-        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at Utils") + '\n';
-    }
-    else {
-        return _constants;
-    }
-
-    return nullptr;
-}
-
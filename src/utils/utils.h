@@ -17,15 +17,10 @@ public:
     static Position projectPointAtSegment(const Position &s1, const Position &s2, const Position &point);
     static float distanceToLine(const Position &s1, const Position &s2, const Position &point);
     static float distanceToSegment(const Position &s1, const Position &s2, const Position &point);
-    static bool isInsideGoalArea(VSSRef::Color teamColor, Position pos);
-    static bool isBallInsideGoal(VSSRef::Color teamColor, Position pos);
+    static bool isInsideGoalArea(VSSRef::Color teamColor, Position pos, Constants *constants);
+    static bool isBallInsideGoal(VSSRef::Color teamColor, Position pos, Constants *constants);
     static Position rotatePoint(Position point, float angle);
     static VSSRef::Quadrant getBallQuadrant(Position ballPos);
-    static void setConstants(Constants *constants);
-
-private:
-    static Constants *_constants;
-    static Constants* getConstants();
 };
 
 #endif // UTILS_H
@@ -1,105 +1,278 @@
 #include "entity.h"
 
-int Entity::_id = 0;
-
-Entity::Entity(EntityType type) {
+Entity::Entity(EntityType type, Clock *clock) : _mutexStep(entityTypeName(type) + "::mutexStep") {
     _entityType = type;
-    _id++;               // global id +1
+    _clock = clock;
+    _metrics = nullptr;
+    _networkReactor = nullptr;
+    _entityId = -1;      // id is given by the world
     _entityPriority = 0; // default priority is 0
     _loopFrequency = 60; // default loop frequency is 60
     _isEnabled = true;   // enabling by default
     _loopEnabled = true; // enabling loop by default
+    _isStepped = false;  // free running by default
+    _stepRequested = false;
+    _stepDone = false;
+    _wakeUpRequested = false;
+    _idleTime = -1;       // not idle by default
+    _isIdleOnFrame = false;
+    _isBlockingLoop = false;
 }
 
 void Entity::run(){
+    // Naming thread and loop spans in traces
+    Tracer::setThreadName(entityName() + " #" + std::to_string(entityId()));
+    LockProfiler::setThreadName(entityName() + " #" + std::to_string(entityId()));
+
+    // Applying thread scheduling (CPUs, nice value or real-time policy)
+    _scheduling.applyToCurrentThread(entityName() + " #" + std::to_string(entityId()));
+    std::string loopSpanName = entityName() + "::loop";
+
     initialization();
 
+    // Configured loop frequency overrides the one of the entity
+    if(_scheduling.loopFrequency() > 0) {
+        setLoopFrequency(_scheduling.loopFrequency());
+    }
+
     while(isEnabled()) {
+        // Stepped entities run one loop for each requested step
+        if(isStepped()) {
+            if(waitStepRequest()) {
+                if(isLoopEnabled()) {
+                    TraceSpan loopSpan(loopSpanName.c_str(), "entity");
+                    loop();
+                }
+                finishStep();
+            }
+            continue;
+        }
+
         startTimer();
         if(isLoopEnabled()) {
+            TraceSpan loopSpan(loopSpanName.c_str(), "entity");
             loop();
         }
         stopTimer();
 
+        // Blocking loops already waited (at most a period) inside the loop
+        if(_isBlockingLoop.load(std::memory_order_acquire)) {
+            if(_metrics != nullptr) {
+                _metrics->setLoopTime(_entityType, _entityTimer.getSeconds());
+            }
+            continue;
+        }
+
         long rest = getRemainingTime();
+
+        // Idle entities sleep until woken up (or its deadline)
+        long idleTime = _idleTime.exchange(-1);
+        if(idleTime > rest) {
+            rest = idleTime;
+        }
+
+        // Loop time and overruns
+        if(_metrics != nullptr) {
+            _metrics->setLoopTime(_entityType, _entityTimer.getSeconds());
+            if(rest < 0) {
+                _metrics->incrementLoopOverrun(_entityType);
+            }
+        }
         if(rest >= 0) {
-            msleep(rest);
+            sleepFor(rest);
         }
+        _isIdleOnFrame.store(false, std::memory_order_release);
     }
 
     finalization();
 }
 
 int Entity::entityId() {
-    return _id;
+    return _entityId;
+}
+
+void Entity::setEntityId(int id) {
+    _entityId = id;
 }
 
 void Entity::setLoopFrequency(int hz) {
-    _mutexLoopTime.lock();
-    _loopFrequency = hz;
-    _mutexLoopTime.unlock();
+    _loopFrequency.store(hz, std::memory_order_relaxed);
 }
 
 void Entity::setPriority(int priority) {
-    _mutexPriority.lock();
-    _entityPriority = priority;
-    _mutexPriority.unlock();
+    _entityPriority.store(priority, std::memory_order_relaxed);
 }
 
 void Entity::enableEntity() {
-    _mutexEnabled.lock();
-    _isEnabled = true;
-    _mutexEnabled.unlock();
+    _isEnabled.store(true, std::memory_order_release);
 }
 
 void Entity::disableLoop() {
-    _mutexEnabled.lock();
-    _loopEnabled = false;
-    _mutexEnabled.unlock();
+    _loopEnabled.store(false, std::memory_order_release);
+    wakeUp();
 }
 
 void Entity::stopEntity() {
-    _mutexEnabled.lock();
-    _isEnabled = false;
-    _mutexEnabled.unlock();
+    _isEnabled.store(false, std::memory_order_release);
+
+    // Interrupt loop sleep
+    wakeUp();
+
+    // Interrupt step waits
+    _mutexStep.lock();
+    _stepCondition.wakeAll();
+    _mutexStep.unlock();
 }
 
-int Entity::loopFrequency() {
-    _mutexLoopTime.lock();
-    int loopFrequency = _loopFrequency;
-    _mutexLoopTime.unlock();
+void Entity::wakeUp() {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _wakeUpRequested = true;
+    _sleepCondition.notify_all();
+}
 
-    return loopFrequency;
+void Entity::idleFor(long microSeconds, bool wakeOnFrame) {
+    _idleTime.store(microSeconds);
+    _isIdleOnFrame.store(wakeOnFrame, std::memory_order_release);
 }
 
-int Entity::entityPriority() {
-    _mutexPriority.lock();
-    int entityPriority = _entityPriority;
-    _mutexPriority.unlock();
+void Entity::wakeUpOnFrame() {
+    // Only entities idle waiting for frames are woken (others keep their period)
+    if(_isIdleOnFrame.load(std::memory_order_acquire)) {
+        wakeUp();
+    }
+}
 
-    return entityPriority;
+void Entity::setBlockingLoop(bool isBlockingLoop) {
+    _isBlockingLoop.store(isBlockingLoop, std::memory_order_release);
 }
 
-bool Entity::isEnabled() {
-    _mutexEnabled.lock();
-    bool isEnabled = _isEnabled;
-    _mutexEnabled.unlock();
+void Entity::sleepFor(long microSeconds) {
+    std::unique_lock<std::mutex> lock(_sleepMutex);
 
-    return isEnabled;
+    // Wait remaining time, unless woken up (requests made while looping are not lost)
+    _sleepCondition.wait_for(lock, std::chrono::microseconds(microSeconds), [this]() { return _wakeUpRequested || !isEnabled(); });
+    _wakeUpRequested = false;
+}
+
+void Entity::setStepped(bool isStepped) {
+    _mutexStep.lock();
+    _isStepped.store(isStepped, std::memory_order_release);
+    _stepCondition.wakeAll();
+    _mutexStep.unlock();
+
+    // Mode switch takes effect at the next iteration
+    wakeUp();
+}
+
+void Entity::runStep() {
+    _mutexStep.lock();
+
+    // Request step
+    _stepRequested = true;
+    _stepDone = false;
+    _stepCondition.wakeAll();
+
+    // Wait loop to finish (or entity to stop, stopEntity() wakes it)
+    while(!_stepDone && isEnabled()) {
+        _mutexStep.wait(&_stepCondition, 100);
+    }
+
+    _mutexStep.unlock();
+}
+
+bool Entity::waitStepRequest() {
+    _mutexStep.lock();
+
+    // Wait step (stopEntity() and setStepped() wake it)
+    while(!_stepRequested && isEnabled() && isStepped()) {
+        _mutexStep.wait(&_stepCondition, 100);
+    }
+    bool stepRequested = _stepRequested;
+
+    _mutexStep.unlock();
+
+    return stepRequested;
+}
+
+void Entity::finishStep() {
+    _mutexStep.lock();
+    _stepRequested = false;
+    _stepDone = true;
+    _stepCondition.wakeAll();
+    _mutexStep.unlock();
+}
+
+int Entity::loopFrequency() {
+    return _loopFrequency.load(std::memory_order_relaxed);
+}
+
+int Entity::entityPriority() {
+    return _entityPriority.load(std::memory_order_relaxed);
+}
+
+bool Entity::isEnabled() {
+    return _isEnabled.load(std::memory_order_acquire);
 }
 
 bool Entity::isLoopEnabled() {
-    _mutexEnabled.lock();
-    bool loopEnabled = _loopEnabled;
-    _mutexEnabled.unlock();
+    return _loopEnabled.load(std::memory_order_acquire);
+}
 
-    return loopEnabled;
+bool Entity::isStepped() {
+    return _isStepped.load(std::memory_order_acquire);
 }
 
 EntityType Entity::entityType() {
     return _entityType;
 }
 
+void Entity::setScheduling(const Scheduling &scheduling) {
+    _scheduling = scheduling;
+}
+
+void Entity::setMetrics(Metrics *metrics) {
+    _metrics = metrics;
+
+    if(_metrics != nullptr) {
+        _metrics->setEntityName(_entityType, entityName());
+    }
+}
+
+Metrics* Entity::getMetrics() {
+    return _metrics;
+}
+
+void Entity::setNetworkReactor(NetworkReactor *networkReactor) {
+    _networkReactor = networkReactor;
+}
+
+NetworkReactor* Entity::getNetworkReactor() {
+    return _networkReactor;
+}
+
+std::string Entity::entityName() {
+    return entityTypeName(_entityType);
+}
+
+std::string Entity::entityTypeName(EntityType type) {
+    switch(type) {
+        case ENT_VISION: return "Vision";
+        case ENT_REFEREE: return "Referee";
+        case ENT_REPLACER: return "Replacer";
+        case ENT_SIMULATOR: return "Simulator";
+        case ENT_LOCKSTEP: return "Lockstep";
+        case ENT_METRICS: return "Metrics";
+        case ENT_BROADCAST: return "Broadcast";
+        case ENT_REACTOR: return "Reactor";
+        case ENT_GUI: return "GUI";
+        default: return "Entity";
+    }
+}
+
+Clock* Entity::getClock() {
+    return _clock;
+}
+
 void Entity::startTimer() {
     _entityTimer.start();
 }
@@ -109,7 +282,8 @@ void Entity::stopTimer() {
 }
 
 long Entity::getRemainingTime() {
-    long remainingTime = (1000 / _loopFrequency) - _entityTimer.getMiliSeconds();
+    // Using microseconds allows loop frequencies above 1 kHz
+    long remainingTime = (1E6 / loopFrequency()) - _entityTimer.getMicroSeconds();
 
     return remainingTime;
 }
@@ -4,27 +4,69 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include <src/utils/timer/timer.h>
+#include <src/utils/tracer/tracer.h>
+#include <src/utils/logger/logger.h>
+#include <src/utils/metrics/metrics.h>
+#include <src/utils/lockprofiler/lockprofiler.h>
+#include <src/utils/scheduling/scheduling.h>
+
+// Abstract NetworkReactor
+class NetworkReactor;
 
 enum EntityType {
     ENT_VISION,
     ENT_REFEREE,
     ENT_REPLACER,
+    ENT_SIMULATOR,
+    ENT_LOCKSTEP,
+    ENT_METRICS,
+    ENT_BROADCAST,
+    ENT_REACTOR,
     ENT_GUI
 };
 
 class Entity : public QThread
 {
 public:
-    Entity(EntityType type);
+    Entity(EntityType type, Clock *clock = nullptr);
 
     // Setters
     void setLoopFrequency(int hz);
     void setPriority(int priority);
+    void setEntityId(int id);
     void enableEntity();
     void disableLoop();
     void stopEntity();
+    void wakeUp();
+
+    // Idle (the next sleep lasts until wakeUp() or the deadline, and optionally until a new frame)
+    void idleFor(long microSeconds, bool wakeOnFrame = false);
+    void wakeUpOnFrame();
+
+    // Blocking loop (the loop waits by itself, so the entity does not sleep after it)
+    void setBlockingLoop(bool isBlockingLoop);
+
+    // Lockstep (loop runs only when a step is requested)
+    void setStepped(bool isStepped);
+    void runStep();
+
+    // Thread scheduling (applied when the entity starts)
+    void setScheduling(const Scheduling &scheduling);
+
+    // Metrics (nullptr if not exposed)
+    void setMetrics(Metrics *metrics);
+    Metrics* getMetrics();
+
+    // Network reactor (sockets of the entity wake it up on arrival, nullptr if disabled)
+    void setNetworkReactor(NetworkReactor *networkReactor);
+    NetworkReactor* getNetworkReactor();
 
     // Getters
     int loopFrequency();
@@ -32,7 +74,11 @@ public:
     int entityId();
     bool isEnabled();
     bool isLoopEnabled();
+    bool isStepped();
     EntityType entityType();
+    std::string entityName();
+    static std::string entityTypeName(EntityType type);
+    Clock* getClock();
 
 private:
     // Main run method
@@ -43,13 +89,25 @@ private:
     virtual void loop() = 0;
     virtual void finalization() = 0;
 
-    // Entity info
-    int _loopFrequency;
-    int _entityPriority;
-    bool _isEnabled;
-    bool _loopEnabled;
+    // Entity info (control state is read lock-free at every loop)
+    std::atomic<int> _loopFrequency;
+    std::atomic<int> _entityPriority;
+    std::atomic<bool> _isEnabled;
+    std::atomic<bool> _loopEnabled;
     EntityType _entityType;
-    static int _id;
+    int _entityId;
+
+    // Match clock
+    Clock *_clock;
+
+    // Thread scheduling
+    Scheduling _scheduling;
+
+    // Match metrics
+    Metrics *_metrics;
+
+    // Network reactor
+    NetworkReactor *_networkReactor;
 
     // Entity timer
     Timer _entityTimer;
@@ -57,11 +115,23 @@ private:
     void stopTimer();
     long getRemainingTime();
 
-    // Entity mutexes
-    QMutex _mutexRunning;
-    QMutex _mutexEnabled;
-    QMutex _mutexPriority;
-    QMutex _mutexLoopTime;
+    // Loop sleep (interrupted by stopEntity() and wakeUp())
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    bool _wakeUpRequested;
+    void sleepFor(long microSeconds);
+    std::atomic<long> _idleTime;
+    std::atomic<bool> _isIdleOnFrame;
+    std::atomic<bool> _isBlockingLoop;
+
+    // Step control
+    std::atomic<bool> _isStepped;
+    bool _stepRequested;
+    bool _stepDone;
+    ProfiledMutex _mutexStep;
+    QWaitCondition _stepCondition;
+    bool waitStepRequest();
+    void finishStep();
 };
 
 #endif // ENTITY_H
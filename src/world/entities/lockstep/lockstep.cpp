@@ -0,0 +1,178 @@
+#include "lockstep.h"
+
+#include <algorithm>
+
+Lockstep::Lockstep(Vision *vision, Referee *referee, Replacer *replacer, Simulator *simulator, Constants *constants, Clock *clock) : Entity(ENT_LOCKSTEP, clock) {
+    // Take pointers
+    _vision = vision;
+    _referee = referee;
+    _replacer = replacer;
+    _simulator = simulator;
+    _constants = constants;
+
+    // Taking network data
+    _simulatorAddress = getConstants()->simulatorAddress();
+    _simulatorPort = getConstants()->simulatorPort();
+
+    // Init vars
+    _steps = 0;
+    _simulatorClient = nullptr;
+    _commandsServer = nullptr;
+}
+
+void Lockstep::initialization() {
+    // Steps run back to back (as fast as the simulator steps)
+    setLoopFrequency(1000000);
+
+    // Connect to network
+    bindAndConnect();
+
+    // Local simulator frames are published as in free running (teams and viewers take them)
+    if(_simulator != nullptr) {
+        _simulator->openPublisher();
+    }
+
+    _runTimer.start();
+
+    if(_simulator != nullptr) {
+        std::cout << Text::blue("[LOCKSTEP] ", true) + Text::bold("Module started with local simulator, step of " + std::to_string(getConstants()->stepTime()) + " s.") + '\n';
+    }
+    else {
+        std::cout << Text::blue("[LOCKSTEP] ", true) + Text::bold("Module started with simulator at '" + _simulatorAddress.toStdString() + ":" + std::to_string(_simulatorPort) + "', step of " + std::to_string(getConstants()->stepTime()) + " s.") + '\n';
+    }
+}
+
+void Lockstep::loop() {
+    // Take replacements made since last step and teams commands
+    fira_message::sim_to_ref::Packet packet = _replacer->takePendingPacket();
+    takeTeamCommands(&packet);
+
+    // Step simulator
+    fira_message::sim_to_ref::Environment environment;
+    if(!simulate(packet, &environment)) {
+        return ;
+    }
+
+    // Publish frame of local simulator
+    if(_simulator != nullptr) {
+        _simulator->publishEnvironment(environment);
+    }
+
+    // Advance match clock by one step
+    getClock()->advance(getConstants()->stepTime());
+
+    // Feed vision and run referee and replacer once
+    _vision->processEnvironment(environment);
+    _referee->runStep();
+    _replacer->runStep();
+
+    _steps++;
+}
+
+void Lockstep::finalization() {
+    disconnectClient();
+
+    // Close frames output of local simulator
+    if(_simulator != nullptr) {
+        _simulator->closePublisher();
+    }
+
+    // Report steps
+    _runTimer.stop();
+    std::cout << Text::blue("[LOCKSTEP] ", true) + Text::bold("Module finished after " + std::to_string(_steps) + " steps (" + std::to_string(getClock()->getSeconds()) + " s simulated in " + std::to_string(_runTimer.getSeconds()) + " s, " + std::to_string(_steps / std::max(_runTimer.getSeconds(), 1E-9)) + " steps/s).") + '\n';
+}
+
+void Lockstep::bindAndConnect() {
+    if(_simulator != nullptr) {
+        // Local simulator takes teams commands through lockstep
+        _commandsServer = new QUdpSocket();
+        if(_commandsServer->bind(QHostAddress::AnyIPv4, getConstants()->firaPort(), QUdpSocket::ShareAddress) == false) {
+            std::cout << Text::blue("[LOCKSTEP] " , true) << Text::red("Error while binding commands socket.", true) + '\n';
+        }
+    }
+    else {
+        // Simulator answers each packet with an environment
+        _simulatorClient = new QUdpSocket();
+        if(_simulatorClient->bind(QHostAddress::AnyIPv4, 0) == false) {
+            std::cout << Text::blue("[LOCKSTEP] " , true) << Text::red("Error while binding simulator socket.", true) + '\n';
+        }
+    }
+}
+
+void Lockstep::disconnectClient() {
+    QUdpSocket *sockets[2] = {_simulatorClient, _commandsServer};
+    for(int i = 0; i < 2; i++) {
+        if(sockets[i] == nullptr) {
+            continue;
+        }
+
+        if(sockets[i]->isOpen()) {
+            sockets[i]->close();
+        }
+
+        delete sockets[i];
+    }
+
+    _simulatorClient = nullptr;
+    _commandsServer = nullptr;
+}
+
+void Lockstep::takeTeamCommands(fira_message::sim_to_ref::Packet *packet) {
+    if(_commandsServer == nullptr) {
+        return ;
+    }
+
+    while(_commandsServer->hasPendingDatagrams()) {
+        fira_message::sim_to_ref::Packet teamPacket;
+        QNetworkDatagram datagram = _commandsServer->receiveDatagram();
+        if(!datagram.isValid() || !teamPacket.ParseFromArray(datagram.data().data(), datagram.data().size())) {
+            continue;
+        }
+
+        // Keep order (simulator applies them sequentially)
+        packet->MergeFrom(teamPacket);
+    }
+}
+
+bool Lockstep::simulate(const fira_message::sim_to_ref::Packet &packet, fira_message::sim_to_ref::Environment *environment) {
+    // Local simulator
+    if(_simulator != nullptr) {
+        _simulator->simulate(packet, environment, getConstants()->stepTime());
+        return true;
+    }
+
+    // Drop late answers from previous steps
+    while(_simulatorClient->hasPendingDatagrams()) {
+        _simulatorClient->receiveDatagram();
+    }
+
+    // Send packet
+    std::string msg;
+    packet.SerializeToString(&msg);
+    _simulatorClient->writeDatagram(msg.c_str(), msg.size(), QHostAddress(_simulatorAddress), _simulatorPort);
+
+    // Wait environment
+    if(!_simulatorClient->waitForReadyRead(1000)) {
+        Logger::error("LOCKSTEP", "Simulator did not answer step.");
+        return false;
+    }
+
+    QNetworkDatagram datagram = _simulatorClient->receiveDatagram();
+    if(!datagram.isValid() || !environment->ParseFromArray(datagram.data().data(), datagram.data().size())) {
+        Logger::error("LOCKSTEP", "Environment packet parsing error.");
+        return false;
+    }
+
+    return true;
+}
+
+Constants* Lockstep::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at Lockstep") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
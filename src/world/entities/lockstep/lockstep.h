@@ -0,0 +1,51 @@
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+
+#include <src/world/entities/entity.h>
+#include <src/world/entities/vision/vision.h>
+#include <src/world/entities/referee/referee.h>
+#include <src/world/entities/replacer/replacer.h>
+#include <src/world/entities/simulator/simulator.h>
+
+class Lockstep : public Entity
+{
+public:
+    Lockstep(Vision *vision, Referee *referee, Replacer *replacer, Simulator *simulator, Constants *constants, Clock *clock);
+
+private:
+    // Entity inherited methods
+    void initialization();
+    void loop();
+    void finalization();
+
+    // Modules driven by lockstep
+    Vision *_vision;
+    Referee *_referee;
+    Replacer *_replacer;
+
+    // Local simulator (nullptr uses the simulator network)
+    Simulator *_simulator;
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Network
+    QUdpSocket *_simulatorClient;
+    QUdpSocket *_commandsServer;
+    QString _simulatorAddress;
+    quint16 _simulatorPort;
+    void bindAndConnect();
+    void disconnectClient();
+
+    // Step management
+    quint64 _steps;
+    Timer _runTimer;
+    void takeTeamCommands(fira_message::sim_to_ref::Packet *packet);
+    bool simulate(const fira_message::sim_to_ref::Packet &packet, fira_message::sim_to_ref::Environment *environment);
+};
+
+#endif // LOCKSTEP_H
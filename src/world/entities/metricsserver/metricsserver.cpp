@@ -0,0 +1,84 @@
+#include "metricsserver.h"
+
+MetricsServer::MetricsServer(Metrics *metrics, Constants *constants, Clock *clock) : Entity(ENT_METRICS, clock) {
+    // Take pointers
+    _metrics = metrics;
+    _constants = constants;
+
+    // Taking network data
+    _metricsAddress = getConstants()->metricsAddress();
+    _metricsPort = getConstants()->metricsPort();
+}
+
+void MetricsServer::initialization() {
+    // Polling is enough for scrapes
+    setLoopFrequency(20);
+
+    // Creating server (at entity thread)
+    _server = new QTcpServer();
+    if(_server->listen(QHostAddress(_metricsAddress), _metricsPort) == false) {
+        std::cout << Text::blue("[METRICS] ", true) << Text::red("Error while listening at '" + _metricsAddress.toStdString() + ":" + std::to_string(_metricsPort) + "'.", true) + '\n';
+        return ;
+    }
+
+    std::cout << Text::blue("[METRICS] ", true) + Text::bold("Module started at address '" + _metricsAddress.toStdString() + "' and port '" + std::to_string(_metricsPort) + "'.") + '\n';
+}
+
+void MetricsServer::loop() {
+    if(!_server->isListening()) {
+        return ;
+    }
+
+    // Accept pending connections (no event loop at entities)
+    _server->waitForNewConnection(0);
+    while(_server->hasPendingConnections()) {
+        QTcpSocket *client = _server->nextPendingConnection();
+        if(client == nullptr) {
+            break;
+        }
+
+        answerClient(client);
+    }
+}
+
+void MetricsServer::finalization() {
+    // Closing server
+    if(_server->isListening()) {
+        _server->close();
+    }
+
+    // Deleting server
+    delete _server;
+
+    std::cout << Text::blue("[METRICS] ", true) + Text::bold("Module finished.") + '\n';
+}
+
+void MetricsServer::answerClient(QTcpSocket *client) {
+    // Take request (any other request, or none, is answered with the metrics)
+    QByteArray request;
+    if(client->waitForReadyRead(100)) {
+        request = client->readAll();
+    }
+
+    // Lock contention report (on demand), or Prometheus text format (as a HTTP response, so it can be scraped)
+    std::string body = (request.startsWith("GET /locks") && LockProfiler::isEnabled()) ? LockProfiler::report() : _metrics->exposition();
+    std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+
+    client->write(response.c_str(), response.size());
+    client->waitForBytesWritten(100);
+    client->disconnectFromHost();
+    client->close();
+
+    delete client;
+}
+
+Constants* MetricsServer::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at MetricsServer") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
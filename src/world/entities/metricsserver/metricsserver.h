@@ -0,0 +1,35 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <src/world/entities/entity.h>
+#include <src/constants/constants.h>
+
+class MetricsServer : public Entity
+{
+public:
+    MetricsServer(Metrics *metrics, Constants *constants, Clock *clock);
+
+private:
+    // Entity inherited methods
+    void initialization();
+    void loop();
+    void finalization();
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Exposed metrics
+    Metrics *_metrics;
+
+    // Network (answers each connection with the metrics text)
+    QTcpServer *_server;
+    QString _metricsAddress;
+    quint16 _metricsPort;
+    void answerClient(QTcpSocket *client);
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,100 @@
+#include "networkreactor.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+NetworkReactor::NetworkReactor(Constants *constants, Clock *clock) : Entity(ENT_REACTOR, clock) {
+    // Taking constants
+    _constants = constants;
+
+    // Creating epoll (sockets can be added before the reactor starts)
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if(_epollFd == -1) {
+        std::cout << Text::blue("[REACTOR] ", true) << Text::red("Error while creating epoll: " + std::string(strerror(errno)), true) + '\n';
+    }
+
+    // No wake ups yet
+    _wakeUps = 0;
+}
+
+NetworkReactor::~NetworkReactor() {
+    if(_epollFd != -1) {
+        close(_epollFd);
+    }
+}
+
+bool NetworkReactor::addSocket(QUdpSocket *socket, Entity *owner) {
+    if(_epollFd == -1 || socket == nullptr || socket->socketDescriptor() == -1) {
+        return false;
+    }
+
+    // Edge triggered: owner is woken once for each arrival, and it drains the socket at its loop
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLET;
+    event.data.ptr = owner;
+    if(epoll_ctl(_epollFd, EPOLL_CTL_ADD, static_cast<int>(socket->socketDescriptor()), &event) == -1) {
+        Logger::error("REACTOR", "Failed to add socket of %s: %s", owner->entityName().c_str(), strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void NetworkReactor::removeSocket(QUdpSocket *socket) {
+    if(_epollFd == -1 || socket == nullptr || socket->socketDescriptor() == -1) {
+        return ;
+    }
+
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, static_cast<int>(socket->socketDescriptor()), nullptr);
+}
+
+void NetworkReactor::initialization() {
+    // Reactor waits at epoll instead of sleeping between loops
+    setBlockingLoop(_epollFd != -1);
+
+    std::cout << Text::blue("[REACTOR] ", true) + Text::bold("Module started.") + '\n';
+}
+
+void NetworkReactor::loop() {
+    // Without epoll, owners keep reading at their own period
+    if(_epollFd == -1) {
+        idleFor(getConstants()->idleTime() * 1000);
+        return ;
+    }
+
+    // Wait for datagrams (at most a loop period, so stop requests are taken)
+    int eventsCount = epoll_wait(_epollFd, _events, MAX_EVENTS, std::max(1, 1000 / loopFrequency()));
+    if(eventsCount == -1) {
+        if(errno != EINTR) {
+            Logger::error("REACTOR", "Failed to wait sockets: %s", strerror(errno));
+        }
+        return ;
+    }
+
+    // Wake owners (they read the datagrams at their loop)
+    for(int i = 0; i < eventsCount; i++) {
+        static_cast<Entity*>(_events[i].data.ptr)->wakeUp();
+    }
+    _wakeUps += eventsCount;
+
+    if(eventsCount > 0 && getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REACTOR_WAKEUPS, eventsCount);
+    }
+}
+
+void NetworkReactor::finalization() {
+    std::cout << Text::blue("[REACTOR] ", true) + Text::bold("Module finished (" + std::to_string(_wakeUps) + " wake ups).") + '\n';
+}
+
+Constants* NetworkReactor::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at NetworkReactor") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
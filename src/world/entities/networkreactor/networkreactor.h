@@ -0,0 +1,42 @@
+#ifndef NETWORKREACTOR_H
+#define NETWORKREACTOR_H
+
+#include <QUdpSocket>
+
+#include <sys/epoll.h>
+
+#include <src/world/entities/entity.h>
+#include <src/constants/constants.h>
+
+// Waits on the sockets of all entities (epoll) and wakes the owner of a socket as soon as it has datagrams.
+// Sockets are still read by their owners (at the woken loop), so they keep living at the owner thread.
+class NetworkReactor : public Entity
+{
+public:
+    NetworkReactor(Constants *constants, Clock *clock);
+    ~NetworkReactor();
+
+    // Sockets (thread safe, called by the owners after binding and before closing)
+    bool addSocket(QUdpSocket *socket, Entity *owner);
+    void removeSocket(QUdpSocket *socket);
+
+private:
+    // Entity inherited methods
+    void initialization();
+    void loop();
+    void finalization();
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Epoll (events carry the owner entity)
+    static const int MAX_EVENTS = 16;
+    int _epollFd;
+    epoll_event _events[MAX_EVENTS];
+
+    // Dispatched wake ups
+    quint64 _wakeUps;
+};
+
+#endif // NETWORKREACTOR_H
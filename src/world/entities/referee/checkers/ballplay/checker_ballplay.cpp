@@ -26,6 +26,7 @@ void Checker_BallPlay::configure() {
     _possibleGoalKick = false;
     _possibleGoal = false;
     _areaTimerControl = false;
+    _areaTimer.setClock(getClock());
     _areaTimer.start();
 }
 
@@ -46,13 +47,13 @@ void Checker_BallPlay::run() {
         if(passedMidField) {
             setNextTeam();
             setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, _penaltyTeam, VSSRef::Quadrant::NO_QUADRANT);
-            emit foulOccured();
+            reportFoul();
 
             return;
         }
     }
 
-    if(!_areaTimerControl && ((Utils::isInsideGoalArea(VSSRef::Color::BLUE, ballPos) && !Utils::isBallInsideGoal(VSSRef::Color::BLUE, ballPos)) || (Utils::isInsideGoalArea(VSSRef::Color::YELLOW, ballPos) && !Utils::isBallInsideGoal(VSSRef::Color::YELLOW, ballPos)))) {
+    if(!_areaTimerControl && ((Utils::isInsideGoalArea(VSSRef::Color::BLUE, ballPos, getConstants()) && !Utils::isBallInsideGoal(VSSRef::Color::BLUE, ballPos, getConstants())) || (Utils::isInsideGoalArea(VSSRef::Color::YELLOW, ballPos, getConstants()) && !Utils::isBallInsideGoal(VSSRef::Color::YELLOW, ballPos, getConstants())))) {
         // Update control vars
         _isPlayRunning = true;
         if(!_possiblePenalty) {
@@ -84,7 +85,7 @@ void Checker_BallPlay::run() {
         if(_isPlayRunning) {
             // If play was running before, check if occurred an goal or ball just leaved goal area
             for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-                if(Utils::isBallInsideGoal(VSSRef::Color(i), ballPos)) {
+                if(Utils::isBallInsideGoal(VSSRef::Color(i), ballPos, getConstants())) {
                     // Mark possible goal
                     _possibleGoal = true;
                     _possibleGoalTeam = (i == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE;
@@ -98,14 +99,14 @@ void Checker_BallPlay::run() {
                         if(_isPenaltyShootout) {
                             setNextTeam();
                             setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, _penaltyTeam, VSSRef::Quadrant::NO_QUADRANT);
-                            emit foulOccured();
+                            reportFoul();
                             return ;
                         }
                         else {
                             setPenaltiesInfo(VSSRef::Foul::KICKOFF, VSSRef::Color(i), VSSRef::Quadrant::NO_QUADRANT);
                         }
 
-                        emit foulOccured();
+                        reportFoul();
                     }
                     else{
                         if(getConstants()->useRefereeSuggestions()) {
@@ -128,7 +129,7 @@ void Checker_BallPlay::run() {
                 // If any of them occurred, send HALT command
                 if(getConstants()->useRefereeSuggestions()) {
                     setPenaltiesInfo(VSSRef::Foul::HALT);
-                    emit foulOccured();
+                    reportFoul();
                 }
                 else {
                     // Check priority
@@ -136,14 +137,14 @@ void Checker_BallPlay::run() {
                         // Possible goal, possible goal kick and not possible penalty, priority: GOAL_KICK
                         if(_possibleGoalKick && !_possiblePenalty) {
                             setPenaltiesInfo(VSSRef::Foul::GOAL_KICK, _checkerTwoAtk->attackingTeam());
-                            emit foulOccured();
+                            reportFoul();
                         }
                         // Possible goal, possible penalty and not possible goal kick, priority: GOAL
                         else if(!_possibleGoalKick && _possiblePenalty) {
                             emit emitGoal(_possibleGoalTeam);
 
                             setPenaltiesInfo(VSSRef::Foul::KICKOFF, (_possibleGoalTeam == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE, VSSRef::Quadrant::NO_QUADRANT);
-                            emit foulOccured();
+                            reportFoul();
                         }
                         // Possible goal, possible penalty and possible goal kick... priority: the later
                         else if(_possibleGoalKick && _possiblePenalty) {
@@ -160,7 +161,7 @@ void Checker_BallPlay::run() {
                                 setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, (_checkerTwoDef->defendingTeam() == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE);
                             }
 
-                            emit foulOccured();
+                            reportFoul();
                         }
                     }
                     // If no possible goal occurred
@@ -178,7 +179,7 @@ void Checker_BallPlay::run() {
                             setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, (_checkerTwoDef->defendingTeam() == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE);
                         }
 
-                        emit foulOccured();
+                        reportFoul();
                     }
                 }
 
@@ -189,7 +190,7 @@ void Checker_BallPlay::run() {
                 if(_isPenaltyShootout) {
                     setNextTeam();
                     setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, _penaltyTeam, VSSRef::Quadrant::NO_QUADRANT);
-                    emit foulOccured();
+                    reportFoul();
                 }
             }
 
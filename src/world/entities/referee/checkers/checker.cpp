@@ -1,7 +1,7 @@
 #include "checker.h"
 #include <src/world/entities/referee/referee.h>
 
-Checker::Checker(Vision *vision/*, Referee *referee*/, Constants *constants) {
+Checker::Checker(Vision *vision/*, Referee *referee*/, Constants *constants, Clock *clock) {
     // Sets vision module
     _vision = vision;
 
@@ -10,6 +10,12 @@ Checker::Checker(Vision *vision/*, Referee *referee*/, Constants *constants) {
 
     // Sets constants
     _constants = constants;
+
+    // Sets match clock
+    _clock = clock;
+
+    // Fouls are reported once the queue is set
+    _foulQueue = nullptr;
 }
 
 void Checker::setPenaltiesInfo(VSSRef::Foul penalty, VSSRef::Color teamColor, VSSRef::Quadrant quadrant) {
@@ -18,6 +24,16 @@ void Checker::setPenaltiesInfo(VSSRef::Foul penalty, VSSRef::Color teamColor, VS
     _quadrant = quadrant;
 }
 
+void Checker::reportFoul() {
+    if(_foulQueue != nullptr) {
+        _foulQueue->push({this, _penalty, _teamColor, _quadrant});
+    }
+}
+
+void Checker::setFoulQueue(FoulQueue *foulQueue) {
+    _foulQueue = foulQueue;
+}
+
 VSSRef::Foul Checker::penalty() {
     return _penalty;
 }
@@ -62,6 +78,10 @@ Constants* Checker::getConstants() {
 
     return nullptr;
 }
+
+Clock* Checker::getClock() {
+    return _clock;
+}
 /*
 bool Checker::isGameOn() {
     return (getReferee()->getLastPenaltyInfo().first == VSSRef::Foul::GAME_ON);
@@ -5,6 +5,7 @@
 
 #include <src/world/entities/vision/vision.h>
 #include <src/utils/utils.h>
+#include <src/world/entities/referee/foulqueue/foulqueue.h>
 
 // Abstract referee
 class Referee;
@@ -13,7 +14,7 @@ class Checker : public QObject
 {
     Q_OBJECT
 public:
-    Checker(Vision *vision/*, Referee *referee*/, Constants *constants);
+    Checker(Vision *vision/*, Referee *referee*/, Constants *constants, Clock *clock);
 
     // Internal
     virtual QString name() = 0;
@@ -25,10 +26,14 @@ public:
     VSSRef::Color teamColor();
     VSSRef::Quadrant quadrant();
 
+    // Queue where fouls are reported (nullptr if not taken)
+    void setFoulQueue(FoulQueue *foulQueue);
+
 protected:
     Vision* getVision();
     //Referee* getReferee();
     Constants* getConstants();
+    Clock* getClock();
 
     // Getters
     //bool isGameOn();
@@ -36,6 +41,9 @@ protected:
     // Foul penalties setter
     void setPenaltiesInfo(VSSRef::Foul penalty, VSSRef::Color teamColor = VSSRef::Color::NONE, VSSRef::Quadrant quadrant = VSSRef::Quadrant::NO_QUADRANT);
 
+    // Report foul with the last penalties info
+    void reportFoul();
+
 private:
     // Vision module
     Vision *_vision;
@@ -46,13 +54,16 @@ private:
     // Constants
     Constants *_constants;
 
+    // Match clock
+    Clock *_clock;
+
     // Penalties info
     VSSRef::Foul _penalty;
     VSSRef::Color _teamColor;
     VSSRef::Quadrant _quadrant;
 
-signals:
-    void foulOccured();
+    // Foul queue
+    FoulQueue *_foulQueue;
 };
 
 #endif // CHECKER_H
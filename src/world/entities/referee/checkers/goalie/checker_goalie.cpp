@@ -17,7 +17,7 @@ void Checker_Goalie::configure() {
         // Creating timers for each player
         for(int j = 0; j < getConstants()->qtPlayers(); j++) {
             // Create Timer pointer
-            Timer *playerTimer = new Timer();
+            Timer *playerTimer = new Timer(getClock());
 
             // Reset it
             playerTimer->start();
@@ -52,7 +52,7 @@ void Checker_Goalie::run() {
             Timer *playerTimer = teamHash->value(avPlayers.at(j));
 
             // Check if is inside goal
-            if(Utils::isInsideGoalArea(VSSRef::Color(i), playerPos)) {
+            if(Utils::isInsideGoalArea(VSSRef::Color(i), playerPos, getConstants())) {
                 // Stop player timer
                 playerTimer->stop();
 
@@ -6,6 +6,7 @@ QString Checker_HalfTime::name() {
 }
 
 void Checker_HalfTime::configure() {
+    _timer.setClock(getClock());
     _timer.start();
     _secondsPassed = 0.0f;
 }
@@ -27,12 +28,18 @@ void Checker_HalfTime::run() {
         if(!_isPenaltyShootout) _secondsPassed += _timer.getSeconds();
 
         // Check if half passed
+        bool halfEnded = false;
         if(_secondsPassed >= halfTime) {
             _secondsPassed = 0;
-            emit halfPassed();
+            halfEnded = true;
         }
 
         _secondsMutex.unlock();
+
+        // Emitted unlocked (connected slot runs at this thread and takes the timestamp)
+        if(halfEnded) {
+            emit halfPassed();
+        }
     }
 
     // Restart timer
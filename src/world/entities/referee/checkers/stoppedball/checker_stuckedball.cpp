@@ -6,6 +6,7 @@ QString Checker_StuckedBall::name() {
 }
 
 void Checker_StuckedBall::configure() {
+    _timer.setClock(getClock());
     _timer.start();
     _isLastStuckAtGoalArea = false;
     emit sendStuckedTime(0.0f);
@@ -32,7 +33,7 @@ void Checker_StuckedBall::run() {
 
         // Check if ball is inside both goal areas
         for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-            if(Utils::isInsideGoalArea(VSSRef::Color(i), ballPosition)) {
+            if(Utils::isInsideGoalArea(VSSRef::Color(i), ballPosition, getConstants())) {
                 // Reset timer if is the first time that ball stuck in goal area
                 if(!_isLastStuckAtGoalArea) {
                     _isLastStuckAtGoalArea = true;
@@ -52,7 +53,7 @@ void Checker_StuckedBall::run() {
                     else {
                         setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, ((i == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE), VSSRef::Quadrant::NO_QUADRANT);
                     }
-                    emit foulOccured();
+                    reportFoul();
 
                     // Reset timer
                     _timer.start();
@@ -79,12 +80,12 @@ void Checker_StuckedBall::run() {
                 if(_isPenaltyShootout) {
                     setNextTeam();
                     setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, _penaltyTeam, VSSRef::Quadrant::NO_QUADRANT);
-                    emit foulOccured();
+                    reportFoul();
                 }
                 else {
                     // Set penalties and emit that an foul occured
                     setPenaltiesInfo(VSSRef::Foul::FREE_BALL, VSSRef::Color::NONE, Utils::getBallQuadrant(ballPosition));
-                    emit foulOccured();
+                    reportFoul();
                 }
 
                 // Reset timer
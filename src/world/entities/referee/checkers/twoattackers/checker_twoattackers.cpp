@@ -7,7 +7,7 @@ QString Checker_TwoAttackers::name() {
 void Checker_TwoAttackers::configure() {
     // Insert and start timers
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        _timers.insert(VSSRef::Color(i), new Timer());
+        _timers.insert(VSSRef::Color(i), new Timer(getClock()));
         _timers.value(VSSRef::Color(i))->start();
     }
 
@@ -28,19 +28,19 @@ void Checker_TwoAttackers::run() {
         int countAtOppositeGoal = 0;
         for(int j = 0; j < avPlayers.size(); j++) {
             Position playerPosition = getVision()->getPlayerPosition(VSSRef::Color(i), avPlayers.at(j));
-            if(Utils::isInsideGoalArea(oppositeColor, playerPosition)) {
+            if(Utils::isInsideGoalArea(oppositeColor, playerPosition, getConstants())) {
                 countAtOppositeGoal = countAtOppositeGoal + 1;
             }
         }
 
         // Check if >= 2 and enable flag
-        if(countAtOppositeGoal >= 2 && Utils::isInsideGoalArea(oppositeColor, ballPosition)) {
+        if(countAtOppositeGoal >= 2 && Utils::isInsideGoalArea(oppositeColor, ballPosition, getConstants())) {
             _twoAttacking.insert(VSSRef::Color(oppositeColor), true);
             _timers.value(VSSRef::Color(i))->stop();
 
             if(_timers.value(VSSRef::Color(i))->getSeconds() >= getConstants()->ballInAreaMaxTime() && !getConstants()->useRefereeSuggestions()) {
                 setPenaltiesInfo(VSSRef::Foul::GOAL_KICK, oppositeColor, VSSRef::Quadrant::NO_QUADRANT);
-                emit foulOccured();
+                reportFoul();
             }
         }
         else {
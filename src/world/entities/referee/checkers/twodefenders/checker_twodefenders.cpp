@@ -7,7 +7,7 @@ QString Checker_TwoDefenders::name() {
 void Checker_TwoDefenders::configure() {
     // Insert and start timers
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        _timers.insert(VSSRef::Color(i), new Timer());
+        _timers.insert(VSSRef::Color(i), new Timer(getClock()));
         _timers.value(VSSRef::Color(i))->start();
     }
 
@@ -28,19 +28,19 @@ void Checker_TwoDefenders::run() {
         int countAtAllieGoal = 0;
         for(int j = 0; j < avPlayers.size(); j++) {
             Position playerPosition = getVision()->getPlayerPosition(VSSRef::Color(i), avPlayers.at(j));
-            if(Utils::isInsideGoalArea(VSSRef::Color(i), playerPosition)) {
+            if(Utils::isInsideGoalArea(VSSRef::Color(i), playerPosition, getConstants())) {
                 countAtAllieGoal = countAtAllieGoal + 1;
             }
         }
 
         // Check if >= 2 and enable flag
-        if(countAtAllieGoal >= 2 && Utils::isInsideGoalArea(VSSRef::Color(i), ballPosition)) {
+        if(countAtAllieGoal >= 2 && Utils::isInsideGoalArea(VSSRef::Color(i), ballPosition, getConstants())) {
             _twoDefending.insert(VSSRef::Color(i), true);
             _timers.value(VSSRef::Color(i))->stop();
 
             if(_timers.value(VSSRef::Color(i))->getSeconds() >= getConstants()->ballInAreaMaxTime() && !getConstants()->useRefereeSuggestions()) {
                 setPenaltiesInfo(VSSRef::Foul::PENALTY_KICK, oppositeColor, VSSRef::Quadrant::NO_QUADRANT);
-                emit foulOccured();
+                reportFoul();
             }
         }
         else {
@@ -0,0 +1,82 @@
+#include "commandstream.h"
+
+#include <chrono>
+#include <cstring>
+
+#include <src/utils/logger/logger.h>
+
+CommandStream::CommandStream() {
+    // No command sent yet
+    _hasCommand = false;
+    _sequence = 0;
+    _sequenceOffset = 0;
+    _sendTimestampOffset = 0;
+}
+
+void CommandStream::setCommand(VSSRef::ref_to_team::VSSRef_Command *command) {
+    // Placeholders (non zero values, so the fields are serialized)
+    command->set_sequence(1);
+    command->set_sendtimestamp(1.0);
+
+    // Serialize command once
+    _datagram.clear();
+    command->SerializeToString(&_datagram);
+
+    // Fields are serialized by number, so the fixed ones are the last two (tag + 8 bytes each)
+    _hasCommand = false;
+    if(_datagram.size() < 2 * FIXED_FIELD_SIZE) {
+        Logger::error("REFEREE", "Command serialized without heartbeat fields.");
+        return ;
+    }
+
+    _sequenceOffset = _datagram.size() - 2 * FIXED_FIELD_SIZE;
+    _sendTimestampOffset = _datagram.size() - FIXED_FIELD_SIZE;
+    if(_datagram[_sequenceOffset] != fixedTag(VSSRef::ref_to_team::VSSRef_Command::kSequenceFieldNumber) || _datagram[_sendTimestampOffset] != fixedTag(VSSRef::ref_to_team::VSSRef_Command::kSendTimestampFieldNumber)) {
+        Logger::error("REFEREE", "Command serialized without heartbeat fields.");
+        return ;
+    }
+
+    _hasCommand = true;
+}
+
+bool CommandStream::hasCommand() {
+    return _hasCommand;
+}
+
+const std::string& CommandStream::nextDatagram() {
+    if(!_hasCommand) {
+        return _datagram;
+    }
+
+    // Patch sequence
+    _sequence++;
+    writeFixed64(&_datagram[_sequenceOffset + 1], _sequence);
+
+    // Patch send timestamp (double is sent as its bits)
+    double sendTimestamp = now();
+    quint64 sendTimestampBits;
+    memcpy(&sendTimestampBits, &sendTimestamp, sizeof(sendTimestampBits));
+    writeFixed64(&_datagram[_sendTimestampOffset + 1], sendTimestampBits);
+
+    return _datagram;
+}
+
+quint64 CommandStream::sequence() {
+    return _sequence;
+}
+
+char CommandStream::fixedTag(int fieldNumber) {
+    // Wire type 1 (64 bits)
+    return static_cast<char>((fieldNumber << 3) | 1);
+}
+
+void CommandStream::writeFixed64(char *buffer, quint64 value) {
+    // Little endian (protobuf wire format)
+    for(int i = 0; i < 8; i++) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+double CommandStream::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() / 1E6;
+}
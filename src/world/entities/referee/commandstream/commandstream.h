@@ -0,0 +1,39 @@
+#ifndef COMMANDSTREAM_H
+#define COMMANDSTREAM_H
+
+#include <QtGlobal>
+
+#include <string>
+
+#include <include/vssref_command.pb.h>
+
+// Keeps the last command serialized, only its sequence and send timestamp are patched at each send
+class CommandStream
+{
+public:
+    CommandStream();
+
+    // Command (serialized once, when it changes)
+    void setCommand(VSSRef::ref_to_team::VSSRef_Command *command);
+    bool hasCommand();
+
+    // Datagram of the next send (sequence increased, send timestamp taken now)
+    const std::string& nextDatagram();
+    quint64 sequence();
+
+private:
+    // Serialized command
+    std::string _datagram;
+    bool _hasCommand;
+
+    // Patched fields (fixed size, serialized at the end of the command)
+    static const size_t FIXED_FIELD_SIZE = 9;
+    size_t _sequenceOffset;
+    size_t _sendTimestampOffset;
+    quint64 _sequence;
+    static char fixedTag(int fieldNumber);
+    static void writeFixed64(char *buffer, quint64 value);
+    static double now();
+};
+
+#endif // COMMANDSTREAM_H
@@ -0,0 +1,48 @@
+#include "foulqueue.h"
+
+FoulQueue::FoulQueue() {
+    _head = 0;
+    _size = 0;
+    _droppedEvents = 0;
+}
+
+bool FoulQueue::push(const FoulEvent &event) {
+    if(_size == CAPACITY) {
+        _droppedEvents++;
+        return false;
+    }
+
+    _events[(_head + _size) % CAPACITY] = event;
+    _size++;
+
+    return true;
+}
+
+bool FoulQueue::pop(FoulEvent *event) {
+    if(_size == 0) {
+        return false;
+    }
+
+    *event = _events[_head];
+    _head = (_head + 1) % CAPACITY;
+    _size--;
+
+    return true;
+}
+
+void FoulQueue::clear() {
+    _head = 0;
+    _size = 0;
+}
+
+int FoulQueue::size() {
+    return _size;
+}
+
+bool FoulQueue::isEmpty() {
+    return (_size == 0);
+}
+
+quint64 FoulQueue::droppedEvents() {
+    return _droppedEvents;
+}
@@ -0,0 +1,43 @@
+#ifndef FOULQUEUE_H
+#define FOULQUEUE_H
+
+#include <QtGlobal>
+
+#include <include/vssref_common.pb.h>
+
+// Abstract checker
+class Checker;
+
+// Foul reported by a checker
+struct FoulEvent {
+    Checker *checker;
+    VSSRef::Foul foul;
+    VSSRef::Color teamColor;
+    VSSRef::Quadrant quadrant;
+};
+
+// Fixed-capacity queue of fouls (filled by the checkers and consumed by the Referee, both at the Referee thread)
+class FoulQueue
+{
+public:
+    FoulQueue();
+
+    // Queue management (events are dropped if full)
+    bool push(const FoulEvent &event);
+    bool pop(FoulEvent *event);
+    void clear();
+
+    // Getters
+    int size();
+    bool isEmpty();
+    quint64 droppedEvents();
+
+private:
+    static const int CAPACITY = 16;
+    FoulEvent _events[CAPACITY];
+    int _head;
+    int _size;
+    quint64 _droppedEvents;
+};
+
+#endif // FOULQUEUE_H
@@ -6,7 +6,7 @@
 #include <include/vssref_command.pb.h>
 #include <src/soccerview/soccerview.h>
 
-Referee::Referee(Vision *vision, Replacer *replacer, SoccerView *soccerView, Constants *constants) : Entity(ENT_REFEREE) {
+Referee::Referee(Vision *vision, Replacer *replacer, SoccerView *soccerView, Constants *constants, Clock *clock) : Entity(ENT_REFEREE, clock), _foulMutex("Referee::foulMutex"), _settleDetector(vision, constants) {
     // Take vision pointer
     _vision = vision;
 
@@ -23,50 +23,53 @@ Referee::Referee(Vision *vision, Replacer *replacer, SoccerView *soccerView, Con
     _refereeAddress = getConstants()->refereeAddress();
     _refereePort = getConstants()->refereePort();
 
-    // Connecting referee to replacer
-    connect(_replacer, SIGNAL(teamsPlaced()), this, SLOT(teamsPlaced()));
-    connect(this, SIGNAL(sendFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)), _replacer, SLOT(takeFoul(VSSRef::Foul, VSSRef::Color, VSSRef::Quadrant)));
-    connect(this, SIGNAL(callReplacer()), _replacer, SLOT(placeTeams()), Qt::DirectConnection);
-    connect(this, SIGNAL(placeOutside(VSSRef::Foul, VSSRef::Color)), _replacer, SLOT(placeOutside(VSSRef::Foul, VSSRef::Color)), Qt::DirectConnection);
-    connect(this, SIGNAL(saveFrame()), _replacer, SLOT(saveFrameAndBall()), Qt::DirectConnection);
-    connect(this, SIGNAL(placeFrame()), _replacer, SLOT(placeLastFrameAndBall()), Qt::DirectConnection);
-    connect(this, SIGNAL(placeBall(Position, Velocity)), _replacer, SLOT(placeBall(Position, Velocity)), Qt::DirectConnection);
-
-    // Init signal mapper
-    _mapper = new QSignalMapper();
+    // Transitions follow the match clock
+    _transitionTimer.setClock(getClock());
+
+    // Game state before the first command is sent
+    _lastFoul = VSSRef::Foul::HALT;
+    _gameHalted = false;
+    _longStop = false;
+    _isPenaltyShootout = false;
+
+    // Latency tracing is disabled by default
+    _latencyTracker = nullptr;
 }
 
 void Referee::initialization() {
     // Adding checkers
     // Stucked ball
-    addChecker(_stuckedBallChecker = new Checker_StuckedBall(_vision, getConstants()), 0);
+    addChecker(_stuckedBallChecker = new Checker_StuckedBall(_vision, getConstants(), getClock()), 0);
     connect(_stuckedBallChecker, SIGNAL(sendStuckedTime(float)), this, SLOT(takeStuckedTime(float)));
     _stuckedBallChecker->setIsPenaltyShootout(false, VSSRef::Color::NONE);
 
     // Two attackers
-    addChecker(_twoAtkChecker = new Checker_TwoAttackers(_vision, getConstants()), 1);
+    addChecker(_twoAtkChecker = new Checker_TwoAttackers(_vision, getConstants(), getClock()), 1);
 
     // Two defenders
-    addChecker(_twoDefChecker = new Checker_TwoDefenders(_vision, getConstants()), 1);
+    addChecker(_twoDefChecker = new Checker_TwoDefenders(_vision, getConstants(), getClock()), 1);
 
     // Ball play
-    addChecker(_ballPlayChecker = new Checker_BallPlay(_vision, getConstants()), 2);
+    addChecker(_ballPlayChecker = new Checker_BallPlay(_vision, getConstants(), getClock()), 2);
     connect(_ballPlayChecker, SIGNAL(emitGoal(VSSRef::Color)), _soccerView, SLOT(addGoal(VSSRef::Color)));
     connect(_ballPlayChecker, SIGNAL(emitSuggestion(QString, VSSRef::Color, VSSRef::Quadrant)), _soccerView, SLOT(addSuggestion(QString, VSSRef::Color, VSSRef::Quadrant)));
     _ballPlayChecker->setAtkDefCheckers(_twoAtkChecker, _twoDefChecker);
     _ballPlayChecker->setIsPenaltyShootout(false, VSSRef::Color::NONE);
 
     // Goalie
-    _goalieChecker = new Checker_Goalie(_vision, getConstants());
+    _goalieChecker = new Checker_Goalie(_vision, getConstants(), getClock());
     connect(_goalieChecker, SIGNAL(updateGoalie(VSSRef::Color, quint8)), _replacer, SLOT(takeGoalie(VSSRef::Color, quint8)));
     addChecker(_goalieChecker, 0);
 
     // HalfTime
-    _halfChecker = new Checker_HalfTime(_vision, getConstants());
+    _halfChecker = new Checker_HalfTime(_vision, getConstants(), getClock());
     _halfChecker->setReferee(this);
     _halfChecker->setIsPenaltyShootout(false);
-    connect(_halfChecker, SIGNAL(halfPassed()), this, SLOT(halfPassed()));
+    _halfChecker->configure();
+    // Half passed runs at the Referee thread (it sends commands to the replacer), reading only thread safe match data of the GUI
+    connect(_halfChecker, SIGNAL(halfPassed()), this, SLOT(halfPassed()), Qt::DirectConnection);
     connect(_soccerView, SIGNAL(addTime(int)), _halfChecker, SLOT(receiveTime(int)), Qt::DirectConnection);
+    connect(_soccerView, SIGNAL(addTime(int)), this, SLOT(takeWakeUp()), Qt::DirectConnection);
 
     // Set default initial state
     _gameHalf = VSSRef::NO_HALF;
@@ -76,6 +79,8 @@ void Referee::initialization() {
     _isEndGame = false;
     _isPenaltyShootout = false;
     _placedLast = true;
+    _isBallHeld = false;
+    _savedTransitionTime = 0.0;
 
     // Take first kickoff team
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
@@ -93,15 +98,23 @@ void Referee::initialization() {
 }
 
 void Referee::loop() {
+    // Take replacer answers and manual fouls
+    takeReplacerAcks();
+    takeManualFouls();
+
+    // Resend last command (if heartbeat period passed)
+    sendHeartbeat();
+
     // Run half checker
     _halfChecker->run();
 
     // Send timestampaa
     emit sendTimestamp((_halfChecker->isOvertime() ? getConstants()->overtimeHalfTime() : getConstants()->halfTime()), _halfChecker->getTimeStamp(), _gameHalf, _isEndGame);
 
-    // Game halted just return
+    // Game halted, hold ball and idle until the deadline (or manual command), when the ball is checked again
     if(_gameHalted) {
-        emit placeBall(_lastBallPosition, Velocity(true, 0.0, 0.0));
+        holdBall();
+        idleFor(getIdleTime());
         return ;
     }
 
@@ -109,7 +122,12 @@ void Referee::loop() {
     if(_longStop) {
         _transitionTimer.stop();
 
-        if(_transitionTimer.getSeconds() >= (60 * getConstants()->transitionTime())) {
+        // Idle until the end of long stop (or manual command)
+        double remainingTime = (60 * getConstants()->transitionTime()) - _transitionTimer.getSeconds();
+        if(remainingTime > 0.0) {
+            idleFor(static_cast<long>(std::min(remainingTime * 1E6, static_cast<double>(getIdleTime()))));
+        }
+        else {
             resetTransitionVars();
 
             // Check if last foul is stop
@@ -132,6 +150,11 @@ void Referee::loop() {
         // Sort from higher to lower priority
         std::sort(priorityKeys.begin(), priorityKeys.end(), std::greater<int>());
 
+        // Checkers evaluate the last published vision frame
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->beginEvaluation();
+        }
+
         for(it = priorityKeys.begin(); it != priorityKeys.end(); it++) {
             // Take fouls with priority (*it)
             QVector<Checker*> *checkers = _checkers.value((*it));
@@ -141,12 +164,29 @@ void Referee::loop() {
                 Checker *atChecker = checkers->at(i);
 
                 // Run it
+                TraceSpan checkerSpan("checker", "referee");
+                if(checkerSpan.isActive()) {
+                    checkerSpan.setName(atChecker->name() + "::run");
+                }
+                int reportedFouls = _foulQueue.size();
                 atChecker->run();
+
+                // Trace foul when it is reported
+                if(_latencyTracker != nullptr && _foulQueue.size() > reportedFouls) {
+                    _latencyTracker->markFoul();
+                }
             }
         }
 
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->endEvaluation();
+        }
+
         // Reset transition management vars
         resetTransitionVars();
+
+        // Dispatch reported fouls
+        dispatchFouls();
     }
     // Else if game is not on, wait, go to stop and set game on again
     else {
@@ -158,21 +198,18 @@ void Referee::loop() {
             // Stop timer
             _transitionTimer.stop();
 
-            _transitionMutex.lock();
-            bool teamsPlaced = _teamsPlaced;
-            _transitionMutex.unlock();
-
-            // Check if passed transition time
-            if(_transitionTimer.getSeconds() >= getConstants()->transitionTime() || (teamsPlaced && _transitionTimer.getSeconds() >= (getConstants()->transitionTime() / 2.0))) {
+            // Check if passed transition time (or teams placed and robots stopped)
+            if(_transitionTimer.getSeconds() >= getConstants()->transitionTime() || (_teamsPlaced && (_transitionTimer.getSeconds() >= (getConstants()->transitionTime() / 2.0) || isTransitionSettled(_transitionTimer.getSeconds(), getConstants()->transitionTime() / 2.0)))) {
                 // Set control vars
                 _isStopped = true;
                 _resetedTimer = false;
+                _settleDetector.resetFrames();
 
                 // Call replacer (place teams)
-                emit callReplacer();
+                sendToReplacer(ReplacerCommand::PLACE_TEAMS);
 
                 if(_isToPlaceOutside) {
-                    emit placeOutside(_lastFoul, (_lastFoulTeam == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE);
+                    sendToReplacer(ReplacerCommand::PLACE_OUTSIDE, _lastFoul, (_lastFoulTeam == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE);
                     _isToPlaceOutside = false;
                 }
 
@@ -190,8 +227,8 @@ void Referee::loop() {
             // Stop timer
             _transitionTimer.stop();
 
-            // Check if passed transition time
-            if(_transitionTimer.getSeconds() >= getConstants()->transitionTime()) {
+            // Check if passed transition time (or robots settled at their placements)
+            if(_transitionTimer.getSeconds() >= getConstants()->transitionTime() || (_settleDetector.hasTargets() && isTransitionSettled(_transitionTimer.getSeconds(), getConstants()->transitionTime()))) {
                 // Update sent foul to GAME_ON
                 updatePenaltiesInfo(VSSRef::Foul::GAME_ON, VSSRef::Color::NONE, VSSRef::Quadrant::NO_QUADRANT);
                 sendPenaltiesToNetwork();
@@ -207,6 +244,11 @@ void Referee::finalization() {
     // Disconnect client
     disconnectClient();
 
+    // Report transition time saved by settle detection
+    if(getConstants()->useSettleDetection()) {
+        std::cout << Text::blue("[REFEREE] ", true) + Text::bold("Saved " + std::to_string(_savedTransitionTime) + "s of transition time (robots settled).") + '\n';
+    }
+
     std::cout << Text::blue("[REFEREE] ", true) + Text::bold("Module finished.") + '\n';
 }
 
@@ -214,6 +256,10 @@ bool Referee::isGameOn() {
     return (_lastFoul == VSSRef::Foul::GAME_ON && !_gameHalted && !_longStop && !_isPenaltyShootout);
 }
 
+void Referee::setLatencyTracker(LatencyTracker *latencyTracker) {
+    _latencyTracker = latencyTracker;
+}
+
 void Referee::connectClient() {
     // Create socket pointer
     _refereeClient = new QUdpSocket();
@@ -225,6 +271,11 @@ void Referee::connectClient() {
 
     // Connect to referee address and port
     _refereeClient->connectToHost(_refereeAddress, _refereePort, QIODevice::WriteOnly, QAbstractSocket::IPv4Protocol);
+
+    // Create command ring for co-located teams
+    if(getConstants()->useSharedMemory()) {
+        _commandRing.create(getConstants()->commandRing().toStdString(), ShmRing::PAYLOAD_COMMAND, getConstants()->ringSlots(), getConstants()->ringSlotSize());
+    }
 }
 
 void Referee::disconnectClient() {
@@ -235,6 +286,9 @@ void Referee::disconnectClient() {
 
     // Delete client
     delete _refereeClient;
+
+    // Close command ring
+    _commandRing.close();
 }
 
 void Referee::addChecker(Checker *checker, int priority) {
@@ -249,10 +303,8 @@ void Referee::addChecker(Checker *checker, int priority) {
 
     // Check if foul is already added
     if(!checkerVector->contains(checker)) {
-        // Connect in map
-        connect(checker, SIGNAL(foulOccured()), _mapper, SLOT(map()), Qt::UniqueConnection);
-        _mapper->setMapping(checker, checker);
-        connect(_mapper, SIGNAL(mapped(QObject *)), this, SLOT(processChecker(QObject *)), Qt::UniqueConnection);
+        // Fouls are reported to referee queue
+        checker->setFoulQueue(&_foulQueue);
 
         // Call configure method
         checker->configure();
@@ -295,6 +347,24 @@ void Referee::resetTransitionVars() {
     _teamsPlaced = false;
     _gameHalted = false;
     _longStop = false;
+    _settleDetector.clearTargets();
+}
+
+bool Referee::isTransitionSettled(double transitionTime, double maxTransitionTime) {
+    if(!getConstants()->useSettleDetection() || !_settleDetector.update()) {
+        return false;
+    }
+
+    // Account saved time
+    double savedTime = std::max(0.0, maxTransitionTime - transitionTime);
+    _savedTransitionTime += savedTime;
+    if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REFEREE_TRANSITION_SAVED_MS, static_cast<quint64>(savedTime * 1000.0));
+    }
+
+    Logger::debug("REFEREE", "Robots settled, transition advanced %fs earlier", savedTime);
+
+    return true;
 }
 
 void Referee::updatePenaltiesInfo(VSSRef::Foul foul, VSSRef::Color foulTeam, VSSRef::Quadrant foulQuadrant, bool isManual) {
@@ -323,48 +393,129 @@ void Referee::sendPenaltiesToNetwork() {
     command.set_timestamp(_halfChecker->getTimeStamp());
     command.set_gamehalf(_gameHalf);
 
-    // Serializing protobuf to str
-    std::string datagram;
-    command.SerializeToString(&datagram);
+    // Send foul to replacer before teams see it (their placements are taken at this foul)
+    sendToReplacer(ReplacerCommand::TAKE_FOUL, _lastFoul, _lastFoulTeam, _lastFoulQuadrant);
 
-    // Send via socket
-    if(_refereeClient->write(datagram.c_str(), static_cast<quint64>(datagram.length())) == -1) {
-        std::cout << Text::cyan("[REFEREE] ", true) + Text::red("Failed to write to socket.", true) + '\n';
+    // Serializing protobuf once (heartbeats resend it) and sending via socket
+    _commandStream.setCommand(&command);
+    writeCommand();
+
+    if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REFEREE_COMMANDS_SENT);
+    }
+
+    // Close decision trace (if this command comes from a checker)
+    if(_latencyTracker != nullptr) {
+        _latencyTracker->markSent(_lastFoul);
     }
 
     // Debug sent foul
-    std::cout << Text::blue("[REFEREE] ", true) + Text::yellow("[" + VSSRef::Half_Name(_gameHalf) + ":" + std::to_string(_halfChecker->getTimeStamp()) + "] ", true) + Text::bold("Sent command '" + VSSRef::Foul_Name(_lastFoul) + "' for team '" + VSSRef::Color_Name(_lastFoulTeam) + "' at quadrant '" + VSSRef::Quadrant_Name(_lastFoulQuadrant)) + "'\n";
+    Logger::info("REFEREE", "[%s:%f] Sent command '%s' for team '%s' at quadrant '%s'", VSSRef::Half_Name(_gameHalf).c_str(), _halfChecker->getTimeStamp(), VSSRef::Foul_Name(_lastFoul).c_str(), VSSRef::Color_Name(_lastFoulTeam).c_str(), VSSRef::Quadrant_Name(_lastFoulQuadrant).c_str());
 
-    // Send foul
+    // Send foul to GUI
     emit sendFoul(_lastFoul, _lastFoulTeam, _lastFoulQuadrant);
 
     // Reset checkers
     resetCheckers();
 }
 
-void Referee::processChecker(QObject *checker) {
-    Checker *occurredChecker = static_cast<Checker*>(checker);
+void Referee::writeCommand() {
+    // Take datagram with next sequence and send timestamp
+    const std::string &datagram = _commandStream.nextDatagram();
 
-    if(occurredChecker->penalty() == VSSRef::Foul::HALT) {
-        sendControlFoul(occurredChecker->penalty());
-        _gameHalted = true;
+    // Send via socket
+    if(_refereeClient->write(datagram.c_str(), static_cast<quint64>(datagram.length())) == -1) {
+        Logger::error("REFEREE", "Failed to write to socket.");
+    }
+
+    // Publish same datagram to the command ring
+    if(_commandRing.isOpen() && !_commandRing.write(datagram.c_str(), static_cast<quint32>(datagram.length()))) {
+        Logger::error("REFEREE", "Failed to write to command ring.");
+    }
+
+    // Next heartbeat is a period after this send
+    _heartbeatTimer.start();
+}
+
+void Referee::sendHeartbeat() {
+    if(!getConstants()->useCommandHeartbeat() || !_commandStream.hasCommand()) {
         return ;
     }
 
-    // In penaltyShootout, only hear commands from checker ball play
-    if(_isPenaltyShootout && !(occurredChecker->name() == "Checker_BallPlay" || occurredChecker->name() == "Checker_StuckedBall")) {
+    // Check if heartbeat period passed since last send
+    _heartbeatTimer.stop();
+    if(_heartbeatTimer.getSeconds() < 1.0 / getConstants()->heartbeatFrequency()) {
         return ;
     }
-    else if(_isPenaltyShootout && (occurredChecker->name() == "Checker_BallPlay" || occurredChecker->name() == "Checker_StuckedBall")){
+
+    writeCommand();
+
+    if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REFEREE_HEARTBEATS_SENT);
+    }
+}
+
+long Referee::getIdleTime() {
+    long idleTime = getConstants()->idleTime() * 1000;
+
+    // Wake up in time for the next heartbeat
+    if(getConstants()->useCommandHeartbeat()) {
+        idleTime = std::min(idleTime, static_cast<long>(1E6 / getConstants()->heartbeatFrequency()));
+    }
+
+    return idleTime;
+}
+
+void Referee::dispatchFouls() {
+    FoulEvent foulEvent;
+
+    // Fouls are taken in checkers priority order, the first processed one changes the game state
+    while(_foulQueue.pop(&foulEvent)) {
+        if(processFoul(foulEvent)) {
+            // Remaining fouls were taken at the same frame, before it
+            _foulQueue.clear();
+            break;
+        }
+    }
+}
+
+bool Referee::processFoul(const FoulEvent &foulEvent) {
+    Checker *occurredChecker = foulEvent.checker;
+
+    if(getMetrics() != nullptr) {
+        getMetrics()->incrementFoul(foulEvent.foul);
+    }
+
+    if(_latencyTracker != nullptr) {
+        _latencyTracker->markDispatch();
+    }
+
+    if(foulEvent.foul == VSSRef::Foul::HALT) {
+        sendControlFoul(foulEvent.foul);
+        _gameHalted = true;
+        return true;
+    }
+
+    // In penaltyShootout, only hear commands from checker ball play
+    bool isPenaltyChecker = (occurredChecker == _ballPlayChecker || occurredChecker == _stuckedBallChecker);
+    if(_isPenaltyShootout && !isPenaltyChecker) {
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->cancelDecision();
+        }
+        return false;
+    }
+    else if(_isPenaltyShootout && isPenaltyChecker) {
         // Send penalty foul to place outside
-        takeManualFoul(occurredChecker->penalty(), occurredChecker->teamColor(), VSSRef::NO_QUADRANT, true);
-        _ballPlayChecker->setIsPenaltyShootout(true, occurredChecker->teamColor());
-        _stuckedBallChecker->setIsPenaltyShootout(true, occurredChecker->teamColor());
-        return ;
+        applyManualFoul(foulEvent.foul, foulEvent.teamColor, VSSRef::NO_QUADRANT, true);
+        _ballPlayChecker->setIsPenaltyShootout(true, foulEvent.teamColor);
+        _stuckedBallChecker->setIsPenaltyShootout(true, foulEvent.teamColor);
+        return true;
     }
 
-    updatePenaltiesInfo(occurredChecker->penalty(), occurredChecker->teamColor(), occurredChecker->quadrant());
+    updatePenaltiesInfo(foulEvent.foul, foulEvent.teamColor, foulEvent.quadrant);
     sendPenaltiesToNetwork();
+
+    return true;
 }
 
 void Referee::halfPassed() {
@@ -405,11 +556,11 @@ void Referee::halfPassed() {
     _gameHalf = VSSRef::Half(half);
     int kickoff = ((_halfKickoff + 1) % 2);
     _halfKickoff = VSSRef::Color(kickoff);
-    std::cout << Text::blue("[REFEREE] ", true) + Text::bold("Half passed, now at " + VSSRef::Half_Name(_gameHalf)) + '\n';
+    Logger::info("REFEREE", "Half passed, now at %s", VSSRef::Half_Name(_gameHalf).c_str());
 
     // If is penalty shootout, set penalty kick for one team
     if(_gameHalf == VSSRef::Half::PENALTY_SHOOTOUTS) {
-        takeManualFoul(VSSRef::Foul::PENALTY_KICK, _halfKickoff, VSSRef::Quadrant::NO_QUADRANT, true);
+        applyManualFoul(VSSRef::Foul::PENALTY_KICK, _halfKickoff, VSSRef::Quadrant::NO_QUADRANT, true);
         _ballPlayChecker->setIsPenaltyShootout(true, _halfKickoff);
         _stuckedBallChecker->setIsPenaltyShootout(true, _halfKickoff);
         return ;
@@ -425,10 +576,46 @@ void Referee::halfPassed() {
     _longStop = true;
 }
 
-void Referee::teamsPlaced() {
-    _transitionMutex.lock();
-    _teamsPlaced = true;
-    _transitionMutex.unlock();
+void Referee::sendToReplacer(ReplacerCommand::Type type, VSSRef::Foul foul, VSSRef::Color teamColor, VSSRef::Quadrant quadrant) {
+    ReplacerCommand command;
+    command.type = type;
+    command.foul = foul;
+    command.teamColor = teamColor;
+    command.quadrant = quadrant;
+    command.ballPosition = _lastBallPosition;
+    command.ballVelocity = Velocity(true, 0.0, 0.0);
+
+    // Replacer logs dropped commands
+    _replacer->pushCommand(command);
+}
+
+void Referee::takeReplacerAcks() {
+    ReplacerAck ack;
+
+    while(_replacer->takeAck(&ack)) {
+        if(ack.type == ReplacerAck::TEAMS_PLACED) {
+            _teamsPlaced = true;
+        }
+        else {
+            // Placed robots are the settle targets (teams placement replaces the last ones)
+            if(ack.command == ReplacerCommand::PLACE_TEAMS) {
+                _settleDetector.clearTargets();
+            }
+            for(int i = 0; i < ack.targetsCount; i++) {
+                _settleDetector.setTarget(ack.targets[i]);
+            }
+
+            Logger::debug("REFEREE", "Replacer finished command %d", ack.command);
+        }
+    }
+}
+
+void Referee::takeManualFouls() {
+    ManualFoul manualFoul;
+
+    while(_manualFouls.pop(&manualFoul)) {
+        applyManualFoul(manualFoul.foul, manualFoul.foulColor, manualFoul.foulQuadrant, manualFoul.isToPlaceOutside);
+    }
 }
 
 void Referee::sendControlFoul(VSSRef::Foul foul) {
@@ -441,9 +628,10 @@ void Referee::sendControlFoul(VSSRef::Foul foul) {
     if(foul == VSSRef::Foul::HALT) {
         // Take ball last data (before stopping)
         _placedLast = false;
+        _isBallHeld = false;
         _lastBallPosition = _vision->getBallPosition();
         _lastBallVelocity = _vision->getBallVelocity();
-        if(getConstants()->maintainSpeedAtSuggestions()) emit saveFrame();
+        if(getConstants()->maintainSpeedAtSuggestions()) sendToReplacer(ReplacerCommand::SAVE_FRAME);
     }
 
     // Update penalties info
@@ -457,6 +645,17 @@ void Referee::sendControlFoul(VSSRef::Foul foul) {
 }
 
 void Referee::takeManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant, bool isToPlaceOutside) {
+    // Applied at the referee loop (SoccerView runs at another thread)
+    if(!_manualFouls.push({foul, foulColor, foulQuadrant, isToPlaceOutside})) {
+        Logger::error("REFEREE", "Manual foul queue is full, '%s' dropped.", VSSRef::Foul_Name(foul).c_str());
+        return ;
+    }
+
+    // Leave idle state (manual commands take effect now)
+    wakeUp();
+}
+
+void Referee::applyManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant, bool isToPlaceOutside) {
     if(foul == VSSRef::Foul::GAME_ON) {
         // Reset transitions vars
         resetTransitionVars();
@@ -468,7 +667,7 @@ void Referee::takeManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef:
         }
 
         if(!_placedLast) {
-            if(getConstants()->maintainSpeedAtSuggestions()) emit placeFrame();
+            if(getConstants()->maintainSpeedAtSuggestions()) sendToReplacer(ReplacerCommand::PLACE_FRAME);
             _placedLast = true;
         }
 
@@ -497,6 +696,21 @@ void Referee::takeManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef:
     }
 }
 
+void Referee::holdBall() {
+    // Place ball at its halt position once, and again only if it was moved
+    Position ballPosition = _vision->getBallPosition();
+    if(_isBallHeld && (ballPosition.isInvalid() || Utils::distance(ballPosition, _lastBallPosition) <= 0.01f)) {
+        return ;
+    }
+
+    sendToReplacer(ReplacerCommand::PLACE_BALL);
+    _isBallHeld = true;
+}
+
+void Referee::takeWakeUp() {
+    wakeUp();
+}
+
 void Referee::takeStuckedTime(float time) {
     _soccerView->getFieldView()->setStuckedTime(time);
 }
@@ -2,11 +2,14 @@
 #define REFEREE_H
 
 #include <QUdpSocket>
-#include <QSignalMapper>
 
 #include <src/world/entities/entity.h>
 #include <src/world/entities/replacer/replacer.h>
 #include <src/world/entities/referee/checkers/checkers.h>
+#include <src/world/entities/referee/foulqueue/foulqueue.h>
+#include <src/world/entities/referee/settledetector/settledetector.h>
+#include <src/world/entities/referee/commandstream/commandstream.h>
+#include <src/utils/shmring/shmring.h>
 
 // Abstract SoccerView
 class SoccerView;
@@ -15,9 +18,12 @@ class Referee : public Entity
 {
     Q_OBJECT
 public:
-    Referee(Vision *vision, Replacer *replacer, SoccerView *soccerView, Constants *constants);
+    Referee(Vision *vision, Replacer *replacer, SoccerView *soccerView, Constants *constants, Clock *clock);
     bool isGameOn();
 
+    // Latency tracing
+    void setLatencyTracker(LatencyTracker *latencyTracker);
+
 private:
     // Entity inherited methods
     void initialization();
@@ -27,8 +33,10 @@ private:
     // Vision
     Vision *_vision;
 
-    // Replacer
+    // Replacer (commands are sent through its queue, this thread is the only producer)
     Replacer *_replacer;
+    void sendToReplacer(ReplacerCommand::Type type, VSSRef::Foul foul = VSSRef::Foul::GAME_ON, VSSRef::Color teamColor = VSSRef::Color::NONE, VSSRef::Quadrant quadrant = VSSRef::Quadrant::NO_QUADRANT);
+    void takeReplacerAcks();
 
     // SoccerView
     SoccerView *_soccerView;
@@ -40,6 +48,9 @@ private:
     void connectClient();
     void disconnectClient();
 
+    // Command ring (same datagrams of the client, for co-located teams)
+    ShmRing _commandRing;
+
     // Constants
     Constants *_constants;
     Constants* getConstants();
@@ -49,12 +60,18 @@ private:
     VSSRef::Color _lastFoulTeam;
     VSSRef::Quadrant _lastFoulQuadrant;
     bool _isToPlaceOutside;
-    QMutex _foulMutex;
+    ProfiledMutex _foulMutex;
     void updatePenaltiesInfo(VSSRef::Foul foul, VSSRef::Color foulTeam, VSSRef::Quadrant foulQuadrant, bool isManual = false);
     void sendPenaltiesToNetwork();
 
+    // Command heartbeat (last command is resent, so teams that lost it recover)
+    CommandStream _commandStream;
+    Timer _heartbeatTimer;
+    void writeCommand();
+    void sendHeartbeat();
+    long getIdleTime();
+
     // Checker management
-    QSignalMapper *_mapper;
     void addChecker(Checker *checker, int priority);
     void resetCheckers();
     void deleteCheckers();
@@ -62,6 +79,11 @@ private:
     // Checkers
     QHash<int, QVector<Checker*>*> _checkers;
 
+    // Fouls reported by the checkers (dispatched at the end of the checks)
+    FoulQueue _foulQueue;
+    void dispatchFouls();
+    bool processFoul(const FoulEvent &event);
+
     // Stucked ball checker
     Checker_StuckedBall *_stuckedBallChecker;
 
@@ -81,7 +103,6 @@ private:
 
     // Foul transition management
     Timer _transitionTimer;
-    QMutex _transitionMutex;
     bool _resetedTimer;
     bool _isStopped;
     bool _teamsPlaced;
@@ -89,31 +110,46 @@ private:
     bool _isPenaltyShootout;
     void resetTransitionVars();
 
+    // Transition settle (advance before transitionTime when robots are placed and stopped)
+    SettleDetector _settleDetector;
+    double _savedTransitionTime;
+    bool isTransitionSettled(double transitionTime, double maxTransitionTime);
+
+    // Manual fouls (taken from SoccerView, applied at the referee loop)
+    struct ManualFoul {
+        VSSRef::Foul foul;
+        VSSRef::Color foulColor;
+        VSSRef::Quadrant foulQuadrant;
+        bool isToPlaceOutside;
+    };
+    SpscQueue<ManualFoul, 16> _manualFouls;
+    void takeManualFouls();
+    void applyManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant, bool isToPlaceOutside = false);
+
     // Game control
     void sendControlFoul(VSSRef::Foul foul);
     bool _gameHalted;
     bool _longStop;
 
+    // Latency tracing (nullptr if disabled)
+    LatencyTracker *_latencyTracker;
+
     // Halt placement
     Position _lastBallPosition;
     Velocity _lastBallVelocity;
     bool _placedLast;
+    bool _isBallHeld;
+    void holdBall();
 
 signals:
     void sendFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant);
     void sendTimestamp(float halftime, float timestamp, VSSRef::Half half, bool isEndGame);
-    void callReplacer();
-    void placeOutside(VSSRef::Foul foul, VSSRef::Color teamColor);
-    void saveFrame();
-    void placeFrame();
-    void placeBall(Position position, Velocity velocity);
 
 public slots:
-    void processChecker(QObject *checker);
     void halfPassed();
-    void teamsPlaced();
     void takeManualFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant, bool isToPlaceOutside = false);
     void takeStuckedTime(float time);
+    void takeWakeUp();
 };
 
 #endif // REFEREE_H
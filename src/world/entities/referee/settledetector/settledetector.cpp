@@ -0,0 +1,109 @@
+#include "settledetector.h"
+
+#include <math.h>
+
+#include <src/utils/utils.h>
+
+SettleDetector::SettleDetector(Vision *vision, Constants *constants) {
+    // Take pointers
+    _vision = vision;
+    _constants = constants;
+
+    // Init targets and frames
+    _targetsCount = 0;
+    _lastFrame = 0;
+    _firstSettledFrame = 0;
+    _settledFrames = 0;
+}
+
+void SettleDetector::clearTargets() {
+    _targetsCount = 0;
+    resetFrames();
+}
+
+void SettleDetector::setTarget(const PlacementTarget &target) {
+    // Replace target if robot already has one (later placements override)
+    for(int i = 0; i < _targetsCount; i++) {
+        if(_targets[i].teamColor == target.teamColor && _targets[i].playerId == target.playerId) {
+            _targets[i] = target;
+            resetFrames();
+            return ;
+        }
+    }
+
+    if(_targetsCount < ReplacerAck::MAX_TARGETS) {
+        _targets[_targetsCount++] = target;
+    }
+
+    resetFrames();
+}
+
+bool SettleDetector::hasTargets() {
+    return (_targetsCount > 0);
+}
+
+void SettleDetector::resetFrames() {
+    _settledFrames = 0;
+}
+
+bool SettleDetector::update() {
+    // Only new vision frames are taken (positions and speeds of the same frame)
+    _vision->takeSnapshot(&_snapshot);
+    if(_snapshot.frameCount != _lastFrame) {
+        _lastFrame = _snapshot.frameCount;
+
+        // Settled frames are counted by vision frame (frames between two settled checks are taken as settled)
+        if(isFrameSettled(_snapshot)) {
+            if(_settledFrames == 0) {
+                _firstSettledFrame = _snapshot.frameCount;
+            }
+            _settledFrames = _snapshot.frameCount - _firstSettledFrame + 1;
+        }
+        else {
+            _settledFrames = 0;
+        }
+    }
+
+    return (_settledFrames >= static_cast<quint64>(getConstants()->settleFrames()));
+}
+
+bool SettleDetector::isFrameSettled(const VisionSnapshot &snapshot) {
+    const float speedThreshold = getConstants()->settleSpeedThreshold();
+    const float positionTolerance = getConstants()->settlePositionTolerance();
+
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        const VisionSnapshot::Team &team = snapshot.teams[i];
+
+        for(int j = 0; j < team.playersCount; j++) {
+            const VisionSnapshot::Player &player = team.players[j];
+
+            // Check speed
+            if(sqrt(pow(player.vx, 2) + pow(player.vy, 2)) > speedThreshold) {
+                return false;
+            }
+
+            // Check distance to target (if it has one)
+            for(int k = 0; k < _targetsCount; k++) {
+                if(_targets[k].teamColor == VSSRef::Color(i) && _targets[k].playerId == player.playerId) {
+                    if(Utils::distance(Position(true, player.x, player.y), Position(true, _targets[k].x, _targets[k].y)) > positionTolerance) {
+                        return false;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+Constants* SettleDetector::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at SettleDetector") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,42 @@
+#ifndef SETTLEDETECTOR_H
+#define SETTLEDETECTOR_H
+
+#include <src/world/entities/vision/vision.h>
+#include <src/world/entities/replacer/replacercommand/replacercommand.h>
+
+// Checks if robots reached their placements and stopped (for a number of vision frames)
+class SettleDetector
+{
+public:
+    SettleDetector(Vision *vision, Constants *constants);
+
+    // Placement targets (robots without target are only checked by speed)
+    void clearTargets();
+    void setTarget(const PlacementTarget &target);
+    bool hasTargets();
+
+    // Settled frames management
+    void resetFrames();
+    bool update();
+
+private:
+    // Vision
+    Vision *_vision;
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Targets
+    PlacementTarget _targets[ReplacerAck::MAX_TARGETS];
+    int _targetsCount;
+
+    // Frames (evaluated on a single snapshot of each vision frame)
+    VisionSnapshot _snapshot;
+    quint64 _lastFrame;
+    quint64 _firstSettledFrame;
+    quint64 _settledFrames;
+    bool isFrameSettled(const VisionSnapshot &snapshot);
+};
+
+#endif // SETTLEDETECTOR_H
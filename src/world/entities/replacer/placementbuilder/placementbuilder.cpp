@@ -0,0 +1,83 @@
+#include "placementbuilder.h"
+
+PlacementBuilder::PlacementBuilder() {
+    // Create arena at the preallocated block
+    _arenaBlock = new char[ARENA_BLOCK_SIZE];
+    google::protobuf::ArenaOptions options;
+    options.initial_block = _arenaBlock;
+    options.initial_block_size = ARENA_BLOCK_SIZE;
+    _arena = new google::protobuf::Arena(options);
+
+    // Preallocate serialization buffer
+    _buffer.reserve(1024);
+
+    _packet = nullptr;
+    begin();
+}
+
+PlacementBuilder::~PlacementBuilder() {
+    delete _arena;
+    delete[] _arenaBlock;
+}
+
+void PlacementBuilder::begin() {
+    // Free last packet at once (initial block is kept)
+    _arena->Reset();
+    _packet = google::protobuf::Arena::CreateMessage<fira_message::sim_to_ref::Packet>(_arena);
+    _isEmpty = true;
+}
+
+void PlacementBuilder::addRobot(VSSRef::Color teamColor, quint8 robotId, double x, double y, double orientation, double vx, double vy) {
+    fira_message::sim_to_ref::RobotReplacement *robotPlacement = _packet->mutable_replace()->add_robots();
+    fira_message::Robot *robotPosition = robotPlacement->mutable_position();
+
+    // Set robot position / data
+    robotPosition->set_robot_id(robotId);
+    robotPosition->set_orientation(orientation);
+    robotPosition->set_x(x);
+    robotPosition->set_y(y);
+    robotPosition->set_vx(vx);
+    robotPosition->set_vy(vy);
+
+    // Set placement data
+    robotPlacement->set_turnon(true);
+    robotPlacement->set_yellowteam(teamColor == VSSRef::Color::YELLOW);
+
+    _isEmpty = false;
+}
+
+void PlacementBuilder::addFrame(const VSSRef::Frame &frame) {
+    for(int i = 0; i < frame.robots_size(); i++) {
+        const VSSRef::Robot &frameRobot = frame.robots(i);
+        addRobot(frame.teamcolor(), frameRobot.robot_id(), frameRobot.x(), frameRobot.y(), frameRobot.orientation());
+    }
+}
+
+void PlacementBuilder::setBall(Position ballPosition, Velocity ballVelocity) {
+    fira_message::sim_to_ref::BallReplacement *ballPlacement = _packet->mutable_replace()->mutable_ball();
+
+    ballPlacement->set_x(ballPosition.x());
+    ballPlacement->set_y(ballPosition.y());
+    ballPlacement->set_vx(ballVelocity.vx());
+    ballPlacement->set_vy(ballVelocity.vy());
+
+    _isEmpty = false;
+}
+
+bool PlacementBuilder::isEmpty() {
+    return _isEmpty;
+}
+
+const fira_message::sim_to_ref::Packet& PlacementBuilder::packet() {
+    return *_packet;
+}
+
+const char* PlacementBuilder::serialize(int *size) {
+    // Serialize into the reused buffer
+    size_t byteSize = _packet->ByteSizeLong();
+    _buffer.resize(byteSize);
+    _packet->SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8*>(&_buffer[0]));
+    *size = static_cast<int>(byteSize);
+
+    return _buffer.data();
+}
@@ -0,0 +1,45 @@
+#ifndef PLACEMENTBUILDER_H
+#define PLACEMENTBUILDER_H
+
+#include <QtGlobal>
+
+#include <google/protobuf/arena.h>
+
+#include <include/packet.pb.h>
+#include <include/vssref_placement.pb.h>
+#include <src/utils/types/position/position.h>
+#include <src/utils/types/velocity/velocity.h>
+
+// Builds one replacement Packet (teams and ball) to be sent in a single datagram
+class PlacementBuilder
+{
+public:
+    PlacementBuilder();
+    ~PlacementBuilder();
+
+    // Start a new placement (previous packet memory is reused)
+    void begin();
+
+    // Placement data
+    void addRobot(VSSRef::Color teamColor, quint8 robotId, double x, double y, double orientation, double vx = 0.0, double vy = 0.0);
+    void addFrame(const VSSRef::Frame &frame);
+    void setBall(Position ballPosition, Velocity ballVelocity);
+    bool isEmpty();
+
+    // Built packet and its serialization (buffer is valid until next serialize)
+    const fira_message::sim_to_ref::Packet& packet();
+    const char* serialize(int *size);
+
+private:
+    // Arena (first block is preallocated and kept between placements)
+    static const size_t ARENA_BLOCK_SIZE = 16 * 1024;
+    char *_arenaBlock;
+    google::protobuf::Arena *_arena;
+    fira_message::sim_to_ref::Packet *_packet;
+    bool _isEmpty;
+
+    // Serialization buffer (grows only if a placement does not fit)
+    std::string _buffer;
+};
+
+#endif // PLACEMENTBUILDER_H
@@ -0,0 +1,190 @@
+#include "placementtemplates.h"
+
+#include <src/utils/types/field/field_default_3v3.h>
+
+PlacementTemplates::PlacementTemplates(Constants *constants) {
+    // Take constants
+    _constants = constants;
+
+    // Build table
+    buildTemplates();
+}
+
+bool PlacementTemplates::formationByFoul(VSSRef::Foul foul, Formation *formation) {
+    switch(foul) {
+        case VSSRef::Foul::PENALTY_KICK: *formation = FORMATION_PENALTY_KICK; return true;
+        case VSSRef::Foul::GOAL_KICK: *formation = FORMATION_GOAL_KICK; return true;
+        case VSSRef::Foul::FREE_BALL: *formation = FORMATION_FREE_BALL; return true;
+        case VSSRef::Foul::KICKOFF: *formation = FORMATION_KICKOFF; return true;
+        default: return false;
+    }
+}
+
+const PlacementTemplates::Template& PlacementTemplates::getTemplate(Formation formation, bool isFoulTeam, bool isLeftSide, VSSRef::Quadrant quadrant, bool isGoalieAtTop) {
+    int quadrantIndex = (quadrant >= 0 && quadrant < QUADRANTS) ? quadrant : VSSRef::Quadrant::NO_QUADRANT;
+
+    return _templates[formation][isFoulTeam][isLeftSide][quadrantIndex][isGoalieAtTop];
+}
+
+void PlacementTemplates::bind(const Template &placementTemplate, VSSRef::Color color, quint8 goalie, QList<quint8> players, VSSRef::Frame *frame) {
+    frame->Clear();
+    frame->set_teamcolor(color);
+
+    // Without field players, team is not placed
+    if(players.size() == 0) return ;
+
+    // Goalkeeper
+    VSSRef::Robot *gk = frame->add_robots();
+    gk->set_robot_id(goalie);
+    gk->set_x(placementTemplate.goalie.x);
+    gk->set_y(placementTemplate.goalie.y);
+    gk->set_orientation(placementTemplate.goalie.orientation);
+
+    // Attacker and support
+    for(int i = 0; i < 2 && players.size() > 0; i++) {
+        VSSRef::Robot *robot = frame->add_robots();
+        robot->set_robot_id(players.takeFirst());
+        robot->set_x(placementTemplate.fieldPlayers[i].x);
+        robot->set_y(placementTemplate.fieldPlayers[i].y);
+        robot->set_orientation(placementTemplate.fieldPlayers[i].orientation);
+    }
+}
+
+void PlacementTemplates::buildTemplates() {
+    for(int formation = 0; formation < FORMATION_COUNT; formation++) {
+        for(int isFoulTeam = 0; isFoulTeam < 2; isFoulTeam++) {
+            for(int isLeftSide = 0; isLeftSide < 2; isLeftSide++) {
+                for(int quadrant = 0; quadrant < QUADRANTS; quadrant++) {
+                    for(int isGoalieAtTop = 0; isGoalieAtTop < 2; isGoalieAtTop++) {
+                        _templates[formation][isFoulTeam][isLeftSide][quadrant][isGoalieAtTop] = buildTemplate(Formation(formation), isFoulTeam, isLeftSide, VSSRef::Quadrant(quadrant), isGoalieAtTop);
+                    }
+                }
+            }
+        }
+    }
+}
+
+PlacementTemplates::Template PlacementTemplates::buildTemplate(Formation formation, bool isFoulTeam, bool isLeftSide, VSSRef::Quadrant quadrant, bool isGoalieAtTop) {
+    Template placementTemplate = {{0.0, 0.0, 0.0}, {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}};
+    Slot &gk = placementTemplate.goalie;
+    Slot &striker = placementTemplate.fieldPlayers[0];
+    Slot &support = placementTemplate.fieldPlayers[1];
+
+    // Side factor
+    float factor = (isLeftSide) ? -1.0 : 1.0;
+    float robotLength = getConstants()->robotLength();
+
+    // FB mark
+    float markX = (Field_Default_3v3::kFieldLength / 1000.0)/2.0 - 0.375;
+    float markY = (Field_Default_3v3::kFieldWidth / 1000.0)/2.0 - 0.25;
+
+    switch(formation) {
+        case FORMATION_PENALTY_KICK: {
+            // isFoulTeam is the team that will make the kick
+            if(isFoulTeam) {
+                gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - robotLength), 0.0, 0.0};
+                striker = {(-factor) * (markX - (2.0 * robotLength)), 0.0, 0.0};
+                support = {factor * (1.5 * robotLength), markY, 0.0};
+            }
+            else {
+                gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - (robotLength / 2.0)), 0.0, 0.0};
+                striker = {(-factor) * (1.5 * robotLength), -markY, 0.0};
+                support = {(-factor) * (1.5 * robotLength), markY - (2.0 * robotLength), 0.0};
+            }
+        }
+        break;
+        case FORMATION_GOAL_KICK: {
+            if(isFoulTeam) {
+                // GK position (top or bottom) is chosen at placement
+                if(isGoalieAtTop) {
+                    gk = {factor * 0.675, 0.270, factor * -45.0};
+                }
+                else {
+                    gk = {factor * 0.675, -0.270, factor * 45.0};
+                }
+                striker = {factor * (markX + robotLength), markY - robotLength, 0.0};
+                support = {factor * (markX - robotLength), -markY - robotLength, 0.0};
+            }
+            else {
+                gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - robotLength), 0.0, 0.0};
+                striker = {(-factor) * (markX - (2.0 * robotLength)), markY - (4.0 * robotLength), 0.0};
+                support = {(-factor) * (markX - (3.0 * robotLength)), -markY + robotLength, 0.0};
+            }
+        }
+        break;
+        case FORMATION_FREE_BALL: {
+            // Mark at foul quadrant
+            if(quadrant == VSSRef::Quadrant::QUADRANT_2 || quadrant == VSSRef::Quadrant::QUADRANT_3)
+                markX *= -1;
+
+            if(quadrant == VSSRef::Quadrant::QUADRANT_3 || quadrant == VSSRef::Quadrant::QUADRANT_4)
+                markY *= -1;
+
+            gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - robotLength), 0.0, 0.0};
+
+            if(isLeftSide) {
+                // If quadrant 2 or 3, gk will need to pos in an better way
+                if(quadrant == VSSRef::Quadrant::QUADRANT_2)
+                    gk.y = robotLength;
+                else if(quadrant == VSSRef::Quadrant::QUADRANT_3)
+                    gk.y = -robotLength;
+
+                striker = {markX - 0.2, markY, 0.0};
+
+                // Support pos in different ways
+                switch(quadrant) {
+                    case VSSRef::Quadrant::QUADRANT_1: support = {0.1, -0.2, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_2: support = {-0.3, -0.1, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_3: support = {-0.3, 0.1, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_4: support = {0.1, 0.2, 0.0}; break;
+                    default: break;
+                }
+            }
+            else {
+                // If quadrant 1 or 4, gk will need to pos in an better way
+                if(quadrant == VSSRef::Quadrant::QUADRANT_1)
+                    gk.y = robotLength;
+                else if(quadrant == VSSRef::Quadrant::QUADRANT_4)
+                    gk.y = -robotLength;
+
+                striker = {markX + 0.2, markY, 0.0};
+
+                // Support pos in different ways
+                switch(quadrant) {
+                    case VSSRef::Quadrant::QUADRANT_1: support = {0.3, -0.1, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_2: support = {-0.1, -0.2, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_3: support = {-0.1, 0.2, 0.0}; break;
+                    case VSSRef::Quadrant::QUADRANT_4: support = {0.3, 0.1, 0.0}; break;
+                    default: break;
+                }
+            }
+        }
+        break;
+        case FORMATION_KICKOFF: {
+            gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - robotLength), 0.0, 0.0};
+            striker = {factor * Field_Default_3v3::kCenterRadius/1000.0, 0.0, 0.0};
+            support = {factor * (Field_Default_3v3::kCenterRadius/1000.0 * 2.0), 0.0, 0.0};
+        }
+        break;
+        case FORMATION_OUTSIDE_FIELD: {
+            gk = {factor * ((Field_Default_3v3::kFieldLength / 2000.0) - robotLength), -0.8, 0.0};
+            striker = {factor * Field_Default_3v3::kCenterRadius/1000.0, -0.8, 0.0};
+            support = {factor * (Field_Default_3v3::kCenterRadius/1000.0 * 2.0), -0.8, 0.0};
+        }
+        break;
+        default: break;
+    }
+
+    return placementTemplate;
+}
+
+Constants* PlacementTemplates::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at PlacementTemplates") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
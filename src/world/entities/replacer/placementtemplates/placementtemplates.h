@@ -0,0 +1,53 @@
+#ifndef PLACEMENTTEMPLATES_H
+#define PLACEMENTTEMPLATES_H
+
+#include <QList>
+
+#include <src/constants/constants.h>
+#include <include/vssref_placement.pb.h>
+
+// Default formations, computed once for both sides (only robot ids are bound at placement)
+class PlacementTemplates
+{
+public:
+    PlacementTemplates(Constants *constants);
+
+    // Formations
+    enum Formation {
+        FORMATION_PENALTY_KICK,
+        FORMATION_GOAL_KICK,
+        FORMATION_FREE_BALL,
+        FORMATION_KICKOFF,
+        FORMATION_OUTSIDE_FIELD,
+        FORMATION_COUNT
+    };
+    static bool formationByFoul(VSSRef::Foul foul, Formation *formation);
+
+    // Templates (goalie and field players positions)
+    struct Slot {
+        double x;
+        double y;
+        double orientation;
+    };
+    struct Template {
+        Slot goalie;
+        Slot fieldPlayers[2];
+    };
+    const Template& getTemplate(Formation formation, bool isFoulTeam, bool isLeftSide, VSSRef::Quadrant quadrant, bool isGoalieAtTop);
+
+    // Bind robot ids (players without the goalie) into frame (frame memory is reused)
+    static void bind(const Template &placementTemplate, VSSRef::Color color, quint8 goalie, QList<quint8> players, VSSRef::Frame *frame);
+
+private:
+    // Templates table, keyed by (formation, foul team, side, quadrant, goalie at top)
+    static const int QUADRANTS = VSSRef::Quadrant::QUADRANT_4 + 1;
+    Template _templates[FORMATION_COUNT][2][2][QUADRANTS][2];
+    void buildTemplates();
+    Template buildTemplate(Formation formation, bool isFoulTeam, bool isLeftSide, VSSRef::Quadrant quadrant, bool isGoalieAtTop);
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+};
+
+#endif // PLACEMENTTEMPLATES_H
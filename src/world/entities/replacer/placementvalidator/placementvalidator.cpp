@@ -0,0 +1,301 @@
+#include "placementvalidator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <src/utils/types/field/field_default_3v3.h>
+#include <src/utils/utils.h>
+
+PlacementValidator::PlacementValidator(Constants *constants) {
+    // Take constants
+    _constants = constants;
+
+    // Robots can not touch at any orientation (half diagonal radius)
+    _robotRadius = getConstants()->robotLength() * std::sqrt(2.0f) / 2.0f;
+    _minDistance = 2.0f * _robotRadius;
+
+    _bodiesCount = 0;
+    _isBudgetExceeded = false;
+}
+
+int PlacementValidator::validate(VSSRef::Frame *blueFrame, VSSRef::Frame *yellowFrame, VSSRef::Foul foul, VSSRef::Color foulColor, Position ballPosition, quint8 blueGoalie, quint8 yellowGoalie) {
+    _startTime = std::chrono::steady_clock::now();
+    _isBudgetExceeded = false;
+
+    // Take robots of both teams
+    _bodiesCount = 0;
+    addBodies(blueFrame, blueGoalie);
+    addBodies(yellowFrame, yellowGoalie);
+
+    // Fix rules until placement is legal (a fix can break another rule)
+    static const int MAX_PASSES = 8;
+    for(int i = 0; i < MAX_PASSES && hasBudget(); i++) {
+        bool moved = false;
+        moved |= checkFieldBounds();
+        moved |= checkGoalAreas();
+        moved |= checkBallMark(ballPosition);
+        if(foul == VSSRef::Foul::KICKOFF) {
+            moved |= checkKickoff(foulColor);
+        }
+        moved |= checkOverlaps();
+
+        if(!moved) {
+            break;
+        }
+    }
+
+    // Write corrected robots back
+    int corrected = 0;
+    for(int i = 0; i < _bodiesCount; i++) {
+        Body &body = _bodies[i];
+        if(body.isCorrected) {
+            body.robot->set_x(body.x);
+            body.robot->set_y(body.y);
+            corrected++;
+        }
+    }
+
+    return corrected;
+}
+
+bool PlacementValidator::isBudgetExceeded() {
+    return _isBudgetExceeded;
+}
+
+void PlacementValidator::addBodies(VSSRef::Frame *frame, quint8 goalie) {
+    for(int i = 0; i < frame->robots_size() && _bodiesCount < MAX_BODIES; i++) {
+        VSSRef::Robot *robot = frame->mutable_robots(i);
+        _bodies[_bodiesCount++] = {robot, frame->teamcolor(), static_cast<float>(robot->x()), static_cast<float>(robot->y()), (robot->robot_id() == goalie), false};
+    }
+}
+
+void PlacementValidator::moveBody(Body *body, float x, float y) {
+    body->x = x;
+    body->y = y;
+    body->isCorrected = true;
+}
+
+int PlacementValidator::cellCoordinate(float value) {
+    return static_cast<int>(std::floor(value / _minDistance));
+}
+
+int PlacementValidator::cellHash(int cellX, int cellY) {
+    return static_cast<int>((static_cast<unsigned int>(cellX) * 73856093u) ^ (static_cast<unsigned int>(cellY) * 19349663u)) & (HASH_SIZE - 1);
+}
+
+void PlacementValidator::buildHash() {
+    for(int i = 0; i < HASH_SIZE; i++) {
+        _cellHeads[i] = -1;
+    }
+
+    for(int i = 0; i < _bodiesCount; i++) {
+        int hash = cellHash(cellCoordinate(_bodies[i].x), cellCoordinate(_bodies[i].y));
+        _cellNext[i] = _cellHeads[hash];
+        _cellHeads[hash] = i;
+    }
+}
+
+bool PlacementValidator::checkFieldBounds() {
+    // Robots aligned to the lines can touch them
+    float halfLength = getConstants()->robotLength() / 2.0f;
+    float maxX = (Field_Default_3v3::kFieldLength / 2000.0) - halfLength;
+    float maxY = (Field_Default_3v3::kFieldWidth / 2000.0) - halfLength;
+    bool moved = false;
+
+    for(int i = 0; i < _bodiesCount; i++) {
+        Body &body = _bodies[i];
+        float x = std::max(-maxX, std::min(maxX, body.x));
+        float y = std::max(-maxY, std::min(maxY, body.y));
+        if(x != body.x || y != body.y) {
+            moveBody(&body, x, y);
+            moved = true;
+        }
+    }
+
+    return moved;
+}
+
+bool PlacementValidator::checkGoalAreas() {
+    float goalX = (Field_Default_3v3::kFieldLength/2.0 - Field_Default_3v3::kDefenseRadius) / 1000.0;
+    float goalY = (Field_Default_3v3::kDefenseStretch / 2.0) / 1000.0;
+    float halfLength = getConstants()->robotLength() / 2.0f;
+    bool moved = false;
+
+    for(int team = VSSRef::Color::BLUE; team <= VSSRef::Color::YELLOW; team++) {
+        // Goalie keeps the area (or the first robot inside it)
+        int keeper = -1;
+        for(int i = 0; i < _bodiesCount; i++) {
+            Body &body = _bodies[i];
+            if(body.teamColor == VSSRef::Color(team) && Utils::isInsideGoalArea(VSSRef::Color(team), Position(true, body.x, body.y), getConstants())) {
+                if(keeper == -1 || (body.isGoalie && !_bodies[keeper].isGoalie)) {
+                    keeper = i;
+                }
+            }
+        }
+
+        // Remove other robots (of both teams) from this team area
+        float sideFactor = teamSideFactor(VSSRef::Color(team));
+        for(int i = 0; i < _bodiesCount; i++) {
+            Body &body = _bodies[i];
+            if(i == keeper || !Utils::isInsideGoalArea(VSSRef::Color(team), Position(true, body.x, body.y), getConstants())) {
+                continue;
+            }
+
+            // Nearest exit (front line or side lines)
+            float frontDistance = std::fabs(body.x * sideFactor - goalX) + halfLength;
+            float sideDistance = goalY - std::fabs(body.y) + halfLength;
+            if(frontDistance <= sideDistance) {
+                moveBody(&body, sideFactor * (goalX - halfLength), body.y);
+            }
+            else {
+                moveBody(&body, body.x, ((body.y >= 0.0f) ? 1.0f : -1.0f) * (goalY + halfLength));
+            }
+            moved = true;
+        }
+    }
+
+    return moved;
+}
+
+bool PlacementValidator::checkBallMark(Position ballPosition) {
+    if(ballPosition.isInvalid()) {
+        return false;
+    }
+
+    float minDistance = _robotRadius + getConstants()->ballRadius();
+    bool moved = false;
+
+    for(int i = 0; i < _bodiesCount; i++) {
+        Body &body = _bodies[i];
+        float dx = body.x - ballPosition.x();
+        float dy = body.y - ballPosition.y();
+        float distance = std::sqrt(dx * dx + dy * dy);
+
+        if(distance < minDistance) {
+            // Push away from the ball (to its own goal if at the mark)
+            if(distance < 1E-4f) {
+                dx = teamSideFactor(body.teamColor);
+                dy = 0.0f;
+                distance = 1.0f;
+            }
+            moveBody(&body, ballPosition.x() + dx / distance * minDistance, ballPosition.y() + dy / distance * minDistance);
+            moved = true;
+        }
+    }
+
+    return moved;
+}
+
+bool PlacementValidator::checkKickoff(VSSRef::Color foulColor) {
+    float centerRadius = Field_Default_3v3::kCenterRadius / 1000.0 + _robotRadius;
+    bool moved = false;
+
+    for(int i = 0; i < _bodiesCount; i++) {
+        Body &body = _bodies[i];
+        float sideFactor = teamSideFactor(body.teamColor);
+
+        // Robots at the opponent half are moved back to their own half
+        if(body.x * sideFactor < 0.0f) {
+            moveBody(&body, sideFactor * _robotRadius, body.y);
+            moved = true;
+        }
+
+        // Team without kickoff outside center circle
+        float distance = std::sqrt(body.x * body.x + body.y * body.y);
+        if(body.teamColor != foulColor && distance < centerRadius) {
+            float dx = (distance < 1E-4f) ? sideFactor : body.x / distance;
+            float dy = (distance < 1E-4f) ? 0.0f : body.y / distance;
+            moveBody(&body, dx * centerRadius, dy * centerRadius);
+            moved = true;
+        }
+    }
+
+    return moved;
+}
+
+bool PlacementValidator::checkOverlaps() {
+    buildHash();
+    bool moved = false;
+
+    for(int i = 0; i < _bodiesCount && hasBudget(); i++) {
+        Body &body = _bodies[i];
+        int cellX = cellCoordinate(body.x);
+        int cellY = cellCoordinate(body.y);
+
+        // Only neighbor cells can hold robots closer than the minimum distance
+        int visitedBuckets[9];
+        int visitedCount = 0;
+        for(int dx = -1; dx <= 1; dx++) {
+            for(int dy = -1; dy <= 1; dy++) {
+                // Neighbor cells can share a bucket, each pair is corrected once
+                int bucket = cellHash(cellX + dx, cellY + dy);
+                if(std::find(visitedBuckets, visitedBuckets + visitedCount, bucket) != visitedBuckets + visitedCount) {
+                    continue;
+                }
+                visitedBuckets[visitedCount++] = bucket;
+
+                for(int j = _cellHeads[bucket]; j != -1; j = _cellNext[j]) {
+                    if(j <= i) {
+                        continue;
+                    }
+
+                    Body &other = _bodies[j];
+                    float diffX = other.x - body.x;
+                    float diffY = other.y - body.y;
+                    float distance = std::sqrt(diffX * diffX + diffY * diffY);
+                    if(distance >= _minDistance - 1E-5f) {
+                        continue;
+                    }
+
+                    // Split correction between both robots (goalies are kept)
+                    if(distance < 1E-4f) {
+                        diffX = 0.0f;
+                        diffY = 1.0f;
+                        distance = 1.0f;
+                    }
+                    float overlap = (_minDistance - distance);
+                    float bodyShare = (body.isGoalie) ? 0.0f : ((other.isGoalie) ? 1.0f : 0.5f);
+                    float ux = diffX / distance;
+                    float uy = diffY / distance;
+
+                    if(bodyShare > 0.0f) {
+                        moveBody(&body, body.x - ux * overlap * bodyShare, body.y - uy * overlap * bodyShare);
+                    }
+                    if(bodyShare < 1.0f) {
+                        moveBody(&other, other.x + ux * overlap * (1.0f - bodyShare), other.y + uy * overlap * (1.0f - bodyShare));
+                    }
+                    moved = true;
+                }
+            }
+        }
+    }
+
+    return moved;
+}
+
+float PlacementValidator::teamSideFactor(VSSRef::Color teamColor) {
+    bool teamIsAtLeft = (teamColor == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (teamColor == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
+
+    return (teamIsAtLeft) ? -1.0f : 1.0f;
+}
+
+bool PlacementValidator::hasBudget() {
+    long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _startTime).count();
+    if(elapsed > getConstants()->placementValidationBudget()) {
+        _isBudgetExceeded = true;
+        return false;
+    }
+
+    return true;
+}
+
+Constants* PlacementValidator::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at PlacementValidator") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
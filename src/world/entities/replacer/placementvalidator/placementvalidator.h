@@ -0,0 +1,66 @@
+#ifndef PLACEMENTVALIDATOR_H
+#define PLACEMENTVALIDATOR_H
+
+#include <chrono>
+
+#include <src/constants/constants.h>
+#include <src/utils/types/position/position.h>
+#include <include/vssref_placement.pb.h>
+
+// Checks both teams placements against the field and foul rules, nudging violators to the closest legal position
+class PlacementValidator
+{
+public:
+    PlacementValidator(Constants *constants);
+
+    // Validate frames in place (returns the number of corrected robots)
+    int validate(VSSRef::Frame *blueFrame, VSSRef::Frame *yellowFrame, VSSRef::Foul foul, VSSRef::Color foulColor, Position ballPosition, quint8 blueGoalie, quint8 yellowGoalie);
+    bool isBudgetExceeded();
+
+private:
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Robots being validated
+    static const int MAX_BODIES = 32;
+    struct Body {
+        VSSRef::Robot *robot;
+        VSSRef::Color teamColor;
+        float x;
+        float y;
+        bool isGoalie;
+        bool isCorrected;
+    };
+    Body _bodies[MAX_BODIES];
+    int _bodiesCount;
+    void addBodies(VSSRef::Frame *frame, quint8 goalie);
+    void moveBody(Body *body, float x, float y);
+
+    // Spatial hash (cells of the minimum distance between robots)
+    static const int HASH_SIZE = 64;
+    int _cellHeads[HASH_SIZE];
+    int _cellNext[MAX_BODIES];
+    int cellCoordinate(float value);
+    int cellHash(int cellX, int cellY);
+    void buildHash();
+
+    // Rules (return true if any robot was moved)
+    bool checkFieldBounds();
+    bool checkGoalAreas();
+    bool checkBallMark(Position ballPosition);
+    bool checkKickoff(VSSRef::Color foulColor);
+    bool checkOverlaps();
+    float teamSideFactor(VSSRef::Color teamColor);
+
+    // Geometry
+    float _robotRadius;
+    float _minDistance;
+
+    // Time budget
+    std::chrono::steady_clock::time_point _startTime;
+    bool _isBudgetExceeded;
+    bool hasBudget();
+};
+
+#endif // PLACEMENTVALIDATOR_H
@@ -2,11 +2,12 @@
 
 #include <random>
 #include <chrono>
+#include <algorithm>
 
 #include <src/utils/types/field/field_default_3v3.h>
 #include <src/utils/utils.h>
 
-Replacer::Replacer(Vision *vision, Constants *constants) : Entity(ENT_REPLACER){
+Replacer::Replacer(Vision *vision, Constants *constants, Clock *clock) : Entity(ENT_REPLACER, clock), _pendingMutex("Replacer::pendingMutex"), _goalieMutex("Replacer::goalieMutex"), _foulMutex("Replacer::foulMutex"), _lastDataMutex("Replacer::lastDataMutex"), _placementTemplates(constants), _placementValidator(constants) {
     // Take pointers
     _vision = vision;
     _constants = constants;
@@ -16,6 +17,24 @@ Replacer::Replacer(Vision *vision, Constants *constants) : Entity(ENT_REPLACER){
     _replacerPort = getConstants()->replacerPort();
     _firaAddress = getConstants()->firaAddress();
     _firaPort = getConstants()->firaPort();
+
+    // Packets are sent to network by default
+    _isLockstep = false;
+
+    // No foul taken yet
+    _foul = VSSRef::Foul::STOP;
+    _foulColor = VSSRef::Color::NONE;
+    _foulQuadrant = VSSRef::Quadrant::NO_QUADRANT;
+
+    // No frame saved yet
+    _hasLastSnapshot = false;
+
+    // Placements received before the first foul are discarded at it
+    _foulEpoch = 0;
+    _isTeamsPlacedAcked = false;
+
+    // Random for goal kick goalie position
+    _goalieRandom.seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 }
 
 void Replacer::bindAndConnect() {
@@ -32,6 +51,9 @@ void Replacer::bindAndConnect() {
         return ;
     }
 
+    // Bound kernel queue (a team flooding placements is dropped by the socket)
+    _replacerClient->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, RECEIVE_BUFFER_SIZE);
+
     // Joining multicast group
     if(_replacerClient->joinMulticastGroup(QHostAddress(_replacerAddress)) == false) {
         std::cout << Text::blue("[VISION] ", true) << Text::red("Error while joining multicast.", true) + '\n';
@@ -40,6 +62,11 @@ void Replacer::bindAndConnect() {
 }
 
 void Replacer::disconnectClient() {
+    // Removing replacer socket from reactor
+    if(getNetworkReactor() != nullptr) {
+        getNetworkReactor()->removeSocket(_replacerClient);
+    }
+
     // Closing replacer socket
     if(_replacerClient->isOpen()) {
         _replacerClient->close();
@@ -66,11 +93,14 @@ void Replacer::initialization() {
     // Set initial frames as empty
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
         _placement.insert(VSSRef::Color(i), VSSRef::Frame());
+        _latePlacement.insert(VSSRef::Color(i), VSSRef::Frame());
     }
 
     // Set initial placed status as false
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
         _placementStatus.insert(VSSRef::Color(i), false);
+        _placementEpoch.insert(VSSRef::Color(i), 0);
+        _latePlacementStatus.insert(VSSRef::Color(i), false);
     }
 
     // Setup initial vars
@@ -80,63 +110,222 @@ void Replacer::initialization() {
     // Connect to network
     bindAndConnect();
 
+    // Wake up when placements arrive (instead of at the next loop period)
+    if(getNetworkReactor() != nullptr) {
+        getNetworkReactor()->addSocket(_replacerClient, this);
+    }
+
     // Debug network info
     std::cout << Text::blue("[REPLACER] ", true) + Text::bold("Module started at address '" + _replacerAddress.toStdString() + "' and port '" + std::to_string(_replacerPort) + "'.") + '\n';
 }
 
 void Replacer::loop() {
-    while(_replacerClient->hasPendingDatagrams()) {
-        QNetworkDatagram datagram;
-        VSSRef::team_to_ref::VSSRef_Placement frame;
+    // Run referee commands first (placements read next belong to the last foul taken)
+    processCommands();
+
+    // Take the latest placement of each team
+    int takenPlacements = receivePlacements();
+
+    // Check if placed ball (held at its last position while teams are placing)
+    if(takenPlacements > 0 && !_placedLastPosition) {
+        placeBall(_lastBallPosition);
+        _placedLastPosition = true;
+    }
+
+    // Check if both placed (referee is acked once per foul)
+    if(!_isTeamsPlacedAcked && _placementStatus.value(VSSRef::Color::BLUE) == true && _placementStatus.value(VSSRef::Color::YELLOW) == true) {
+        ReplacerAck ack;
+        ack.type = ReplacerAck::TEAMS_PLACED;
+        ack.command = ReplacerCommand::TAKE_FOUL;
+        ack.targetsCount = 0;
+        pushAck(ack);
 
-        // Reading datagram and checking if it is valid
-        datagram = _replacerClient->receiveDatagram();
-        if(!datagram.isValid()) {
+        _isTeamsPlacedAcked = true;
+    }
+
+    if(_foulProcessed) {
+        // Update last ball data
+        _lastBallPosition = _vision->getBallPosition();
+        _lastBallVelocity = _vision->getBallVelocity();
+
+        _placedLastPosition = false;
+    }
+}
+
+int Replacer::receivePlacements() {
+    int takenPlacements = 0;
+
+    // Read at most a batch per loop (remaining datagrams wait at the socket buffer)
+    for(int i = 0; i < MAX_DATAGRAMS_PER_LOOP && _replacerClient->hasPendingDatagrams(); i++) {
+        // Reading datagram into the reused buffer
+        _datagramBuffer.resize(std::max(0, static_cast<int>(_replacerClient->pendingDatagramSize())));
+        qint64 datagramSize = _replacerClient->readDatagram(_datagramBuffer.data(), _datagramBuffer.size());
+        if(datagramSize < 0) {
             continue;
         }
 
-        // Parsing datagram and checking if it worked properly
-        if(frame.ParseFromArray(datagram.data().data(), datagram.data().size()) == false) {
-            std::cout << Text::blue("[REPLACER] ", true) << Text::red("Frame packet parsing error.", true) + '\n';
-            continue;
+        if(takePlacementDatagram(_datagramBuffer.constData(), static_cast<int>(datagramSize))) {
+            takenPlacements++;
         }
+    }
 
-        // Check if world has world (frame data)
-        if(frame.has_world()) {
-            // Take frame
-            VSSRef::Frame frameData = frame.world();
+    // Frames that found the foul placed are resolved after the batch
+    takenPlacements += takeLatePlacements();
 
-            // Set frame
-            _placement.insert(frameData.teamcolor(), frameData);
+    return takenPlacements;
+}
 
-            // Set that team placed
-            _placementStatus.insert(frameData.teamcolor(), true);
+bool Replacer::takePlacementDatagram(const char *data, int size) {
+    // Parsing datagram (packet memory is reused) and checking if it worked properly
+    if(_placementPacket.ParseFromArray(data, size) == false) {
+        Logger::error("REPLACER", "Frame packet parsing error.");
+        if(getMetrics() != nullptr) {
+            getMetrics()->increment(Metrics::REPLACER_PARSE_ERRORS);
         }
+        return false;
+    }
+
+    return takePlacement();
+}
+
+bool Replacer::takePlacement() {
+    // Check if packet has a frame of a valid team
+    VSSRef::Color teamColor = _placementPacket.world().teamcolor();
+    if(!_placementPacket.has_world() || (teamColor != VSSRef::Color::BLUE && teamColor != VSSRef::Color::YELLOW) || _placementPacket.world().robots_size() > getConstants()->qtPlayers()) {
+        dropPlacements(1, "invalid frame");
+        return false;
+    }
 
-        // Check if both placed
-        if(_placementStatus.value(VSSRef::Color::BLUE) == true && _placementStatus.value(VSSRef::Color::YELLOW) == true) {
-            // If both placed send signal
-            emit teamsPlaced();
+    if(getMetrics() != nullptr) {
+        getMetrics()->incrementPlacement(teamColor);
+    }
+
+    // Foul already placed, kept until the batch ends (teams can answer a foul still in the command queue)
+    if(_foulProcessed) {
+        if(_latePlacementStatus.value(teamColor)) {
+            dropPlacements(1, "superseded");
         }
 
-        // Check if placed ball
-        if(!_placedLastPosition) {
-            placeBall(_lastBallPosition);
-            _placedLastPosition = true;
+        _latePlacement[teamColor].Swap(_placementPacket.mutable_world());
+        _latePlacementStatus.insert(teamColor, true);
+        return false;
+    }
+
+    // Set frame (swapped, the packet keeps the old memory for the next parse)
+    setPlacement(teamColor, _placementPacket.mutable_world());
+
+    return true;
+}
+
+int Replacer::takeLatePlacements() {
+    if(!_latePlacementStatus.value(VSSRef::Color::BLUE) && !_latePlacementStatus.value(VSSRef::Color::YELLOW)) {
+        return 0;
+    }
+
+    // Run commands queued while the batch was read (a new foul takes these frames)
+    processCommands();
+
+    int takenPlacements = 0;
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        if(!_latePlacementStatus.value(VSSRef::Color(i))) {
+            continue;
+        }
+        _latePlacementStatus.insert(VSSRef::Color(i), false);
+
+        // Foul still placed (late packet of the last foul)
+        if(_foulProcessed) {
+            dropPlacements(1, "late");
+            continue;
         }
+
+        setPlacement(VSSRef::Color(i), &_latePlacement[VSSRef::Color(i)]);
+        takenPlacements++;
     }
 
-    if(_foulProcessed) {
-        // Reset control vars
-        for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-            _placementStatus.insert(VSSRef::Color(i), false);
+    return takenPlacements;
+}
+
+void Replacer::setPlacement(VSSRef::Color teamColor, VSSRef::Frame *frame) {
+    // Newer frame of the same foul replaces the last one
+    if(_placementStatus.value(teamColor) && _placementEpoch.value(teamColor) == _foulEpoch) {
+        dropPlacements(1, "superseded");
+    }
+
+    // Set frame (swapped, the given frame keeps the old memory)
+    _placement[teamColor].Swap(frame);
+
+    // Set that team placed at this foul
+    _placementStatus.insert(teamColor, true);
+    _placementEpoch.insert(teamColor, _foulEpoch);
+}
+
+void Replacer::dropPlacements(quint64 count, const char *reason) {
+    if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REPLACER_PLACEMENTS_DROPPED, count);
+    }
+
+    Logger::debug("REPLACER", "Dropped %llu placement packets (%s) at foul epoch %llu.", static_cast<unsigned long long>(count), reason, static_cast<unsigned long long>(_foulEpoch));
+}
+
+bool Replacer::pushCommand(const ReplacerCommand &command) {
+    if(!_commands.push(command)) {
+        Logger::error("REPLACER", "Command queue is full, command dropped.");
+        return false;
+    }
+
+    // Run it at the next loop
+    wakeUp();
+
+    return true;
+}
+
+bool Replacer::takeAck(ReplacerAck *ack) {
+    return _acks.pop(ack);
+}
+
+void Replacer::pushAck(const ReplacerAck &ack) {
+    if(!_acks.push(ack)) {
+        Logger::warning("REPLACER", "Ack queue is full, ack dropped.");
+    }
+}
+
+void Replacer::processCommands() {
+    ReplacerCommand command;
+
+    while(_commands.pop(&command)) {
+        switch(command.type) {
+            case ReplacerCommand::TAKE_FOUL: takeFoul(command.foul, command.teamColor, command.quadrant); break;
+            case ReplacerCommand::PLACE_TEAMS: placeTeams(); break;
+            case ReplacerCommand::PLACE_OUTSIDE: placeOutside(command.foul, command.teamColor); break;
+            case ReplacerCommand::SAVE_FRAME: saveFrameAndBall(); break;
+            case ReplacerCommand::PLACE_FRAME: placeLastFrameAndBall(); break;
+            case ReplacerCommand::PLACE_BALL: placeBall(command.ballPosition, command.ballVelocity); break;
         }
 
-        // Update last ball data
-        _lastBallPosition = _vision->getBallPosition();
-        _lastBallVelocity = _vision->getBallVelocity();
+        // Answer with the placed robots (if any)
+        ReplacerAck ack;
+        ack.type = ReplacerAck::COMMAND_DONE;
+        ack.command = command.type;
+        ack.targetsCount = 0;
+        if(command.type == ReplacerCommand::PLACE_TEAMS || command.type == ReplacerCommand::PLACE_OUTSIDE) {
+            takePlacementTargets(&ack);
+        }
 
-        _placedLastPosition = false;
+        pushAck(ack);
+    }
+}
+
+void Replacer::takePlacementTargets(ReplacerAck *ack) {
+    // Last placement is kept at the builder
+    const fira_message::sim_to_ref::Replacement &replacement = _placementBuilder.packet().replace();
+
+    for(int i = 0; i < replacement.robots_size() && ack->targetsCount < ReplacerAck::MAX_TARGETS; i++) {
+        const fira_message::sim_to_ref::RobotReplacement &robotPlacement = replacement.robots(i);
+        PlacementTarget &target = ack->targets[ack->targetsCount++];
+        target.teamColor = (robotPlacement.yellowteam()) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE;
+        target.playerId = robotPlacement.position().robot_id();
+        target.x = robotPlacement.position().x();
+        target.y = robotPlacement.position().y();
     }
 }
 
@@ -192,6 +381,16 @@ void Replacer::takeFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quad
     _foulQuadrant = foulQuadrant;
     _foulProcessed = false;
     _foulMutex.unlock();
+
+    // New foul epoch (frames taken before it belong to the last foul)
+    _foulEpoch++;
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        if(_placementStatus.value(VSSRef::Color(i))) {
+            dropPlacements(1, "stale");
+            _placementStatus.insert(VSSRef::Color(i), false);
+        }
+    }
+    _isTeamsPlacedAcked = false;
 }
 
 Position Replacer::getBallPlaceByFoul(VSSRef::Foul foul, VSSRef::Color color, VSSRef::Quadrant quadrant){
@@ -260,387 +459,24 @@ Position Replacer::getBallPlaceByFoul(VSSRef::Foul foul, VSSRef::Color color, VS
     return Position(true, 0.0, 0.0);
 }
 
-VSSRef::Frame Replacer::getPenaltyPlacement(VSSRef::Color color){
-    VSSRef::Frame frame;
-    frame.set_teamcolor(color);
-
+void Replacer::takeDefaultPlacement(PlacementTemplates::Formation formation, VSSRef::Color color, VSSRef::Frame *frame) {
     // swap side check
     bool teamIsAtLeft = (color == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (color == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
+    bool isFoulTeam = (color == getFoulColor());
 
-    float factor = 1.0;
-    if(teamIsAtLeft)
-        factor = -1.0;
-
-    // FB mark
-    float markX = (Field_Default_3v3::kFieldLength / 1000.0)/2.0 - 0.375;
-    float markY = (Field_Default_3v3::kFieldWidth / 1000.0)/2.0 - 0.25;
-
-    QList<quint8> players = _vision->getAvailablePlayers(color);
-    for(int i = 0; i < players.size(); i++) {
-        if(players.at(i) == getGoalie(color)) {
-            players.removeAt(i);
-        }
-    }
-
-    // _color is the team that will make the kick
-    if(color == getFoulColor()){
-        // Insert GK
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        gk->set_orientation(0.0);
-        gk->set_x(factor * ((Field_Default_3v3::kFieldLength / 2000.0) - getConstants()->robotLength()));
-        gk->set_y(0.0);
-
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x((-factor) * (markX - (2.0 * getConstants()->robotLength())));
-        striker->set_y(0.0);
-
-        // Support / Second Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-        support->set_x(factor * (1.5 * getConstants()->robotLength()));
-        support->set_y(markY);
-    }
-    else{
-        // Insert GK
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        gk->set_orientation(0.0);
-        gk->set_x(factor * ((Field_Default_3v3::kFieldLength/2000.0) - (getConstants()->robotLength()/2.0)));
-        gk->set_y(0.0);
-
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x((-factor) * (1.5 * getConstants()->robotLength()));
-        striker->set_y(-markY);
-
-        // Support / Second Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-        support->set_x((-factor) * (1.5 * getConstants()->robotLength()));
-        support->set_y(markY - (2.0 * getConstants()->robotLength()));
+    // Random to choose GK position at goal kick
+    if(formation == PlacementTemplates::FORMATION_GOAL_KICK && isFoulTeam) {
+        _isGoaliePlacedAtTop = _goalieRandom() % 2;
     }
 
-    return frame;
-}
-
-VSSRef::Frame Replacer::getGoalKickPlacement(VSSRef::Color color){
-    VSSRef::Frame frame;
-    frame.set_teamcolor(color);
-
-    // swap side check
-    bool teamIsAtLeft = (color == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (color == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
-
-    float factor = 1.0;
-    if(teamIsAtLeft)
-        factor = -1.0;
-
-    // FB mark
-    float markX = (Field_Default_3v3::kFieldLength / 1000.0)/2.0 - 0.375;
-    float markY = (Field_Default_3v3::kFieldWidth / 1000.0)/2.0 - 0.25;
-
+    // Take players without goalie
+    quint8 goalie = getGoalie(color);
     QList<quint8> players = _vision->getAvailablePlayers(color);
-    for(int i = 0; i < players.size(); i++) {
-        if(players.at(i) == getGoalie(color)) {
-            players.removeAt(i);
-        }
-    }
-
-    // _color is the team that will make the kick
-    if(color == getFoulColor()){
-        // Random to choose GK position
-        auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-        std::mt19937 mt_rand(seed);
-        _isGoaliePlacedAtTop = mt_rand() % 2;
-
-        // Insert GK
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        if(_isGoaliePlacedAtTop){
-            gk->set_orientation(factor * -45.0);
-            gk->set_x(factor * 0.675);
-            gk->set_y(0.270);
-        }
-        else{
-            gk->set_orientation(factor * 45.0);
-            gk->set_x(factor * 0.675);
-            gk->set_y(-0.270);
-        }
+    players.removeOne(goalie);
 
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x((factor) * (markX + getConstants()->robotLength()));
-        striker->set_y(markY - getConstants()->robotLength());
-
-        // Support / Second Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-        support->set_x((factor) * (markX - getConstants()->robotLength()));
-        support->set_y(-markY - getConstants()->robotLength());
-    }
-    else{
-        // Insert GK
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        gk->set_orientation(0.0);
-        gk->set_x(factor * ((Field_Default_3v3::kFieldLength/2000.0) - (getConstants()->robotLength())));
-        gk->set_y(0.0);
-
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x((-factor) * (markX - (2.0 * getConstants()->robotLength())));
-        striker->set_y(markY - (4.0 * getConstants()->robotLength()));
-
-        // Support / Second Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-        support->set_x((-factor) * (markX - (3.0 * getConstants()->robotLength())));
-        support->set_y(-markY + getConstants()->robotLength());
-    }
-
-    return frame;
-}
-
-VSSRef::Frame Replacer::getFreeBallPlacement(VSSRef::Color color){
-    VSSRef::Frame frame;
-    frame.set_teamcolor(color);
-
-    // swap side check
-    bool teamIsAtLeft = (color == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (color == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
-
-    float factor = 1.0;
-    if(teamIsAtLeft)
-        factor = -1.0;
-
-    VSSRef::Quadrant foulQuadrant = getFoulQuadrant();
-
-    // FB Mark
-    float markX = (Field_Default_3v3::kFieldLength / 1000.0)/2.0 - 0.375;
-    float markY = (Field_Default_3v3::kFieldWidth / 1000.0)/2.0 - 0.25;
-
-    if(foulQuadrant == VSSRef::Quadrant::QUADRANT_2 || foulQuadrant == VSSRef::Quadrant::QUADRANT_3)
-        markX *= -1;
-
-    if(foulQuadrant == VSSRef::Quadrant::QUADRANT_3 || foulQuadrant == VSSRef::Quadrant::QUADRANT_4)
-        markY *= -1;
-
-    QList<quint8> players = _vision->getAvailablePlayers(color);
-    for(int i = 0; i < players.size(); i++) {
-        if(players.at(i) == getGoalie(color)) {
-            players.removeAt(i);
-        }
-    }
-
-    // First discover if FB will occur at our side
-    if(teamIsAtLeft){
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        gk->set_orientation(0.0);
-        gk->set_x(factor * ((Field_Default_3v3::kFieldLength / 2000.0) - getConstants()->robotLength()));
-        gk->set_y(0.0);
-
-        // If quadrant 2 or 3, gk will need to pos in an better way
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_2)
-            gk->set_y(getConstants()->robotLength());
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_3)
-            gk->set_y(-getConstants()->robotLength());
-
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x(markX - 0.2);
-        striker->set_y(markY);
-
-        // Support
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-
-        // Support pos in different ways
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_1){
-            support->set_x(0.1);
-            support->set_y(-0.2);
-        }
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_2){
-            support->set_x(-0.3);
-            support->set_y(-0.1);
-        }
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_3){
-            support->set_x(-0.3);
-            support->set_y(0.1);
-        }
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_4){
-            support->set_x(0.1);
-            support->set_y(0.2);
-        }
-    }
-    else{
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *gk = frame.add_robots();
-        gk->set_robot_id(getGoalie(color));
-        gk->set_orientation(0.0);
-        gk->set_x(factor * ((Field_Default_3v3::kFieldLength / 2000.0) - getConstants()->robotLength()));
-        gk->set_y(0.0);
-
-        // If quadrant 2 or 3, gk will need to pos in an better way
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_1)
-            gk->set_y(getConstants()->robotLength());
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_4)
-            gk->set_y(-getConstants()->robotLength());
-
-        // Attacker
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *striker = frame.add_robots();
-        striker->set_robot_id(players.takeFirst());
-        striker->set_orientation(0.0);
-        striker->set_x(markX + 0.2);
-        striker->set_y(markY);
-
-        // Support
-        if(players.size() == 0) return frame;
-        VSSRef::Robot *support = frame.add_robots();
-        support->set_robot_id(players.takeFirst());
-        support->set_orientation(0.0);
-
-        // Support pos in different ways
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_1){
-            support->set_x(0.3);
-            support->set_y(-0.1);
-        }
-        if(foulQuadrant == VSSRef::Quadrant::QUADRANT_2){
-            support->set_x(-0.1);
-            support->set_y(-0.2);
-        }
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_3){
-            support->set_x(-0.1);
-            support->set_y(0.2);
-        }
-        else if(foulQuadrant == VSSRef::Quadrant::QUADRANT_4){
-            support->set_x(0.3);
-            support->set_y(0.1);
-        }
-    }
-
-    return frame;
-}
-
-VSSRef::Frame Replacer::getKickoffPlacement(VSSRef::Color color){
-    VSSRef::Frame frame;
-    frame.set_teamcolor(color);
-
-    // swap side check
-    bool teamIsAtLeft = (color == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (color == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
-
-    float factor = 1.0;
-    if(teamIsAtLeft)
-        factor = -1.0;
-
-    QList<quint8> players = _vision->getAvailablePlayers(color);
-    for(int i = 0; i < players.size(); i++) {
-        if(players.at(i) == getGoalie(color)) {
-            players.removeAt(i);
-        }
-    }
-
-    // Goalkeeper
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *gk = frame.add_robots();
-    gk->set_robot_id(getGoalie(color));
-    gk->set_orientation(0.0);
-    gk->set_x(factor * ((Field_Default_3v3::kFieldLength / 2000.0) - getConstants()->robotLength()));
-    gk->set_y(0.0);
-
-    // Attacker
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *striker = frame.add_robots();
-    striker->set_robot_id(players.takeFirst());
-    striker->set_orientation(0.0);
-    striker->set_x(factor * Field_Default_3v3::kCenterRadius/1000.0);
-    striker->set_y(0.0);
-
-    // Support
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *support = frame.add_robots();
-    support->set_robot_id(players.takeFirst());
-    support->set_orientation(0.0);
-    support->set_x(factor * (Field_Default_3v3::kCenterRadius/1000.0 * 2.0));
-    support->set_y(0.0);
-
-    return frame;
-}
-
-VSSRef::Frame Replacer::getOutsideFieldPlacement(VSSRef::Color color){
-    VSSRef::Frame frame;
-    frame.set_teamcolor(color);
-
-    // swap side check
-    bool teamIsAtLeft = (color == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (color == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
-
-    float factor = 1.0;
-    if(teamIsAtLeft)
-        factor = -1.0;
-
-    QList<quint8> players = _vision->getAvailablePlayers(color);
-    for(int i = 0; i < players.size(); i++) {
-        if(players.at(i) == getGoalie(color)) {
-            players.removeAt(i);
-        }
-    }
-
-    // Goalkeeper
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *gk = frame.add_robots();
-    gk->set_robot_id(getGoalie(color));
-    gk->set_orientation(0.0);
-    gk->set_x(factor * ((Field_Default_3v3::kFieldLength / 2000.0) - getConstants()->robotLength()));
-    gk->set_y(-0.8);
-
-    // Attacker
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *striker = frame.add_robots();
-    striker->set_robot_id(players.takeFirst());
-    striker->set_orientation(0.0);
-    striker->set_x(factor * Field_Default_3v3::kCenterRadius/1000.0);
-    striker->set_y(-0.8);
-
-    // Support
-    if(players.size() == 0) return frame;
-    VSSRef::Robot *support = frame.add_robots();
-    support->set_robot_id(players.takeFirst());
-    support->set_orientation(0.0);
-    support->set_x(factor * (Field_Default_3v3::kCenterRadius/1000.0 * 2.0));
-    support->set_y(-0.8);
-
-    return frame;
+    // Bind ids to the formation template
+    const PlacementTemplates::Template &placementTemplate = _placementTemplates.getTemplate(formation, isFoulTeam, teamIsAtLeft, getFoulQuadrant(), _isGoaliePlacedAtTop);
+    PlacementTemplates::bind(placementTemplate, color, goalie, players, frame);
 }
 
 VSSRef::Frame Replacer::getPenaltyShootoutPlacement(VSSRef::Color color, bool placeAttacker){
@@ -682,7 +518,7 @@ VSSRef::Frame Replacer::getPenaltyShootoutPlacement(VSSRef::Color color, bool pl
         for(int i = 0; i < lastFrame.robots_size(); i++) {
             VSSRef::Robot robot = lastFrame.robots(i);
             Position playerPosition = Position(true, robot.x(), robot.y());
-            if(Utils::isInsideGoalArea(color, playerPosition)) {
+            if(Utils::isInsideGoalArea(color, playerPosition, getConstants())) {
                 id = robot.robot_id();
                 break;
             }
@@ -716,136 +552,82 @@ VSSRef::Frame Replacer::getPenaltyShootoutPlacement(VSSRef::Color color, bool pl
     return frame;
 }
 
-void Replacer::placeFrame(VSSRef::Frame frame) {
-    // Create aux vars
-    fira_message::sim_to_ref::Packet packet;
-    fira_message::sim_to_ref::Replacement *command = new fira_message::sim_to_ref::Replacement();
-    std::string msg;
-
-    // Create robot commands
-    for(int i = 0; i < frame.robots_size(); i++) {
-        fira_message::sim_to_ref::RobotReplacement *robotPlacement = command->add_robots();
-        fira_message::Robot *robotPosition = new fira_message::Robot();
-        VSSRef::Robot frameRobot = frame.robots(i);
-
-        // Set robot position / data
-        robotPosition->set_robot_id(frameRobot.robot_id());
-        robotPosition->set_orientation(frameRobot.orientation());
-        robotPosition->set_x(frameRobot.x());
-        robotPosition->set_y(frameRobot.y());
-        robotPosition->set_vx(0.0);
-        robotPosition->set_vy(0.0);
-
-        // Check if is foul goalie and if it is placed at top or not
-        if(frame.teamcolor() == getFoulColor()) {
-            if(Utils::isInsideGoalArea(frame.teamcolor(), Position(true, frameRobot.x(), frameRobot.y()))){
-                if(frameRobot.y() >= 0) {
-                    _isGoaliePlacedAtTop = true;
-                }
-                else {
-                    _isGoaliePlacedAtTop = false;
-                }
+void Replacer::placeFrame(const VSSRef::Frame &frame) {
+    // Check if is foul goalie and if it is placed at top or not
+    if(frame.teamcolor() == getFoulColor()) {
+        for(int i = 0; i < frame.robots_size(); i++) {
+            const VSSRef::Robot &frameRobot = frame.robots(i);
+            if(Utils::isInsideGoalArea(frame.teamcolor(), Position(true, frameRobot.x(), frameRobot.y()), getConstants())){
+                _isGoaliePlacedAtTop = (frameRobot.y() >= 0);
             }
         }
-
-        // Set placement data
-        robotPlacement->set_turnon(true);
-        robotPlacement->set_yellowteam((frame.teamcolor() == VSSRef::Color::YELLOW) ? true : false);
-        robotPlacement->set_allocated_position(robotPosition);
     }
 
-    // Set replacement to packet
-    packet.set_allocated_replace(command);
-
-    // Send to network
-    packet.SerializeToString(&msg);
-
-    if(_firaClient->write(msg.c_str(), msg.length()) == -1){
-       std::cout << Text::blue("[REPLACER] ", true) + Text::red("FiraClient failed to write to socket.", true) + '\n';
-    }
+    // Add robots to current placement
+    _placementBuilder.addFrame(frame);
 }
 
 void Replacer::placeBall(Position ballPos, Velocity ballVelocity) {
-    // Create aux vars
-    fira_message::sim_to_ref::Packet packet;
-    fira_message::sim_to_ref::Replacement *command = new fira_message::sim_to_ref::Replacement();
-    std::string msg;
-
-    // Create ball place command
-    fira_message::sim_to_ref::BallReplacement *ballPlacement = new fira_message::sim_to_ref::BallReplacement();
-
-    ballPlacement->set_x(ballPos.x());
-    ballPlacement->set_y(ballPos.y());
-    ballPlacement->set_vx(ballVelocity.vx());
-    ballPlacement->set_vy(ballVelocity.vy());
-
-    // Setting replacement into command
-    command->set_allocated_ball(ballPlacement);
-
-    // Setting command into packet
-    packet.set_allocated_replace(command);
+    // Ball alone placement
+    _placementBuilder.begin();
+    _placementBuilder.setBall(ballPos, ballVelocity);
 
     // Send to network
-    packet.SerializeToString(&msg);
-
-    if(_firaClient->write(msg.c_str(), msg.length()) == -1){
-       std::cout << Text::blue("[REPLACER] ", true) + Text::red("FiraClient failed to write to socket.", true) + '\n';
-    }
+    sendPlacement();
 }
 
 void Replacer::placeTeams() {
+    TraceSpan placeSpan("Replacer::placeTeams", "replacer");
+
     VSSRef::Foul lastFoul = getFoul();
 
+    // Take frames of both teams (saved frame memory is reused)
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        // if team placed
-        if(_placementStatus.value(VSSRef::Color(i))) {
-            // Take received frame
-            VSSRef::Frame teamFrame = _placement.take(VSSRef::Color(i));
+        // if team not placed at this foul, take default positions (received frame is already saved otherwise)
+        if(!_placementStatus.value(VSSRef::Color(i)) || _placementEpoch.value(VSSRef::Color(i)) != _foulEpoch) {
+            VSSRef::Frame &defaultFrame = _placement[VSSRef::Color(i)];
 
-            // Send frame to network
-            placeFrame(teamFrame);
+            PlacementTemplates::Formation formation;
+            if(PlacementTemplates::formationByFoul(lastFoul, &formation)) {
+                takeDefaultPlacement(formation, VSSRef::Color(i), &defaultFrame);
+            }
+            else {
+                defaultFrame.Clear();
+            }
+        }
+    }
+
+    VSSRef::Frame &blueFrame = _placement[VSSRef::Color::BLUE];
+    VSSRef::Frame &yellowFrame = _placement[VSSRef::Color::YELLOW];
+    Position foulBallPosition = getBallPlaceByFoul(_foul, _foulColor, _foulQuadrant);
 
-            // Add new empty frame
-            _placement.insert(VSSRef::Color(i), VSSRef::Frame());
+    // Correct illegal placements (overlaps, goal areas, ball mark and field bounds)
+    if(getConstants()->usePlacementValidation()) {
+        int correctedRobots = _placementValidator.validate(&blueFrame, &yellowFrame, lastFoul, getFoulColor(), foulBallPosition, getGoalie(VSSRef::Color::BLUE), getGoalie(VSSRef::Color::YELLOW));
+        if(correctedRobots > 0) {
+            Logger::warning("REPLACER", "Corrected %d robots of placement for '%s'", correctedRobots, VSSRef::Foul_Name(lastFoul).c_str());
         }
-        // if team not placed, take default positions
-        else {
-            // Take default frame
-            VSSRef::Frame defaultFrame;
-
-            switch(lastFoul) {
-                case VSSRef::Foul::FREE_BALL:{
-                    defaultFrame = getFreeBallPlacement(VSSRef::Color(i));
-                }
-                break;
-                case VSSRef::Foul::GOAL_KICK:{
-                    defaultFrame = getGoalKickPlacement(VSSRef::Color(i));
-                }
-                break;
-                case VSSRef::Foul::PENALTY_KICK:{
-                    defaultFrame = getPenaltyPlacement(VSSRef::Color(i));
-                }
-                break;
-                case VSSRef::Foul::KICKOFF:{
-                    defaultFrame = getKickoffPlacement(VSSRef::Color(i));
-                }
-                break;
-                default:{
-                    defaultFrame = VSSRef::Frame();
-                }
-                break;
-            }
+        if(_placementValidator.isBudgetExceeded()) {
+            Logger::warning("REPLACER", "Placement validation stopped at its time budget");
+        }
+    }
 
-            // Send frame to network
-            placeFrame(defaultFrame);
+    // Both teams and ball are sent in one packet
+    _placementBuilder.begin();
+    placeFrame(blueFrame);
+    placeFrame(yellowFrame);
+    _placementBuilder.setBall(foulBallPosition, Velocity(true, 0.0, 0.0));
 
-            // Save frame
-            _placement.insert(VSSRef::Color(i), defaultFrame);
+    // Received frames are used only once
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        if(_placementStatus.value(VSSRef::Color(i))) {
+            _placement[VSSRef::Color(i)].Clear();
+            _placementStatus.insert(VSSRef::Color(i), false);
         }
     }
 
-    Position foulBallPosition = getBallPlaceByFoul(_foul, _foulColor, _foulQuadrant);
-    placeBall(foulBallPosition);
+    // Send to network
+    sendPlacement();
 
     // Mark foul as processed
     _foulMutex.lock();
@@ -854,13 +636,15 @@ void Replacer::placeTeams() {
 }
 
 void Replacer::placeOutside(VSSRef::Foul foul, VSSRef::Color oppositeTeam) {
+    _placementBuilder.begin();
+
     if(foul == VSSRef::Foul::KICKOFF) {
         VSSRef::Frame removedFrame;
 
         // Filling frames
-        removedFrame = getOutsideFieldPlacement(oppositeTeam);
+        takeDefaultPlacement(PlacementTemplates::FORMATION_OUTSIDE_FIELD, oppositeTeam, &removedFrame);
 
-        // Send frames to network
+        // Add frames to placement
         placeFrame(removedFrame);
     }
     else if(foul == VSSRef::Foul::PENALTY_KICK) {
@@ -871,77 +655,27 @@ void Replacer::placeOutside(VSSRef::Foul foul, VSSRef::Color oppositeTeam) {
         removedFrameKicker = getPenaltyShootoutPlacement((oppositeTeam == VSSRef::Color::BLUE) ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE, true);
         removedFrameGoalie = getPenaltyShootoutPlacement(oppositeTeam, false);
 
-        // Send frames to network
+        // Add frames to placement
         placeFrame(removedFrameKicker);
         placeFrame(removedFrameGoalie);
     }
-}
-
-void Replacer::clearLastData() {
-    // Take team frames
-    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        if(_lastFrame.contains(VSSRef::Color(i))) {
-            // Take hash
-            QHash<quint8, fira_message::Robot*> *hash = _lastFrame.value(VSSRef::Color(i));
-
-            // Take keys
-            QList<quint8> keys = hash->keys();
-            for(int j = 0; j < keys.size(); j++) {
-                // Take robot
-                fira_message::Robot *robot = hash->value(keys.at(j));
-
-                // Delete
-                delete robot;
-            }
 
-            // Clear hash
-            hash->clear();
-        }
+    // Send to network
+    if(!_placementBuilder.isEmpty()) {
+        sendPlacement();
     }
-
-    _lastFrame.clear();
 }
 
 void Replacer::saveFrameAndBall() {
     _lastDataMutex.lock();
 
-    // Update last ball data
-    _lastBallPosition = _vision->getBallPosition();
-    _lastBallVelocity = _vision->getBallVelocity();
-
-    // Take team frames
-    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        // Creating hash
-        if(!_lastFrame.contains(VSSRef::Color(i))) {
-            _lastFrame.insert(VSSRef::Color(i), new QHash<quint8, fira_message::Robot*>());
-        }
-
-        // Taking hash
-        QHash<quint8, fira_message::Robot*> *hash = _lastFrame.value(VSSRef::Color(i));
-
-        // Taking available robots
-        QList<quint8> avPlayers = _vision->getAvailablePlayers(VSSRef::Color(i));
-        for(int j = 0; j < avPlayers.size(); j++) {
-            // Creating RobotReplacement
-            if(!hash->contains(avPlayers.at(j))) {
-                hash->insert(avPlayers.at(j), new fira_message::Robot());
-            }
+    // Take all objects from the same vision frame
+    _vision->takeSnapshot(&_lastSnapshot);
+    _hasLastSnapshot = true;
 
-            // Taking data from vision
-            Position robotPosition = _vision->getPlayerPosition(VSSRef::Color(i), avPlayers.at(j));
-            Angle robotOrientation = _vision->getPlayerOrientation(VSSRef::Color(i), avPlayers.at(j));
-            Velocity robotVelocity = _vision->getPlayerVelocity(VSSRef::Color(i), avPlayers.at(j));
-
-            // Filling robot data
-            fira_message::Robot *robotData = hash->value(avPlayers.at(j));
-            robotData->set_robot_id(avPlayers.at(j));
-            robotData->set_x(robotPosition.x());
-            robotData->set_y(robotPosition.y());
-            robotData->set_vx(robotVelocity.vx());
-            robotData->set_vy(robotVelocity.vy());
-            robotData->set_orientation(robotOrientation.value() * (180.0 / M_PI));
-        }
-    }
+    // Update last ball data
+    _lastBallPosition = Position(_lastSnapshot.isBallValid, _lastSnapshot.ballX, _lastSnapshot.ballY);
+    _lastBallVelocity = Velocity(_lastSnapshot.isBallValid, _lastSnapshot.ballVx, _lastSnapshot.ballVy);
 
     _lastDataMutex.unlock();
 }
@@ -949,53 +683,77 @@ void Replacer::saveFrameAndBall() {
 void Replacer::placeLastFrameAndBall() {
     _lastDataMutex.lock();
 
-    // Place ball
-    placeBall(_lastBallPosition, _lastBallVelocity);
+    // Nothing saved to place
+    if(!_hasLastSnapshot) {
+        _lastDataMutex.unlock();
+        return ;
+    }
+
+    // Ball and both teams are sent in one packet
+    _placementBuilder.begin();
+    _placementBuilder.setBall(_lastBallPosition, _lastBallVelocity);
 
-    // Create robot commands
+    // Replay saved robots (only the ones vision still sees, lost robots are not placed back)
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-        // Taking hash and av players
-        QHash<quint8, fira_message::Robot*> *lastTeamFrame = _lastFrame.value(VSSRef::Color(i));
+        const VisionSnapshot::Team &team = _lastSnapshot.teams[i];
         QList<quint8> avPlayers = _vision->getAvailablePlayers(VSSRef::Color(i));
 
-        // Create aux vars
-        fira_message::sim_to_ref::Packet packet;
-        fira_message::sim_to_ref::Replacement *command = new fira_message::sim_to_ref::Replacement();
-        std::string msg;
-
-        for(int j = 0; j < avPlayers.size(); j++) {
-            // Avoid take data if player is not contained in last frame
-            if(!lastTeamFrame->contains(avPlayers.at(j))) {
+        for(int j = 0; j < team.playersCount; j++) {
+            const VisionSnapshot::Player &player = team.players[j];
+            if(!avPlayers.contains(player.playerId)) {
                 continue;
             }
 
-            // Creating robot in command
-            fira_message::sim_to_ref::RobotReplacement *robotPlacement = command->add_robots();
+            _placementBuilder.addRobot(VSSRef::Color(i), player.playerId, player.x, player.y, player.orientation * (180.0 / M_PI), player.vx, player.vy);
+        }
+    }
+
+    // Send to network
+    sendPlacement();
 
-            // Taking data from hash
-            fira_message::Robot *robot = new fira_message::Robot();
-            robot->CopyFrom(*lastTeamFrame->value(avPlayers.at(j)));
+    // Saved frame is consumed by its placement (as the saved robots were cleared before), the next one comes with the next halt
+    _hasLastSnapshot = false;
 
-            // Setting data to robotPlacement
-            robotPlacement->set_turnon(true);
-            robotPlacement->set_yellowteam((i == VSSRef::Color::BLUE) ? false : true);
-            robotPlacement->set_allocated_position(robot);
-        }
+    _lastDataMutex.unlock();
+}
 
-        // Set replacement to packet
-        packet.set_allocated_replace(command);
+void Replacer::setLockstep(bool isLockstep) {
+    _pendingMutex.lock();
+    _isLockstep = isLockstep;
+    _pendingMutex.unlock();
+}
 
-        // Send to network
-        packet.SerializeToString(&msg);
+fira_message::sim_to_ref::Packet Replacer::takePendingPacket() {
+    _pendingMutex.lock();
+    fira_message::sim_to_ref::Packet packet;
+    packet.Swap(&_pendingPacket);
+    _pendingMutex.unlock();
 
-        if(_firaClient->write(msg.c_str(), msg.length()) == -1){
-           std::cout << Text::blue("[REPLACER] ", true) + Text::red("FiraClient failed to write to socket.", true) + '\n';
-        }
+    return packet;
+}
+
+void Replacer::sendPlacement() {
+    _pendingMutex.lock();
+
+    // In lockstep, placements are merged and sent with the next simulation step
+    if(_isLockstep) {
+        _pendingPacket.MergeFrom(_placementBuilder.packet());
+        _pendingMutex.unlock();
+        return ;
     }
 
-    clearLastData();
+    _pendingMutex.unlock();
 
-    _lastDataMutex.unlock();
+    // Serialize (reused buffer) and send to network
+    int size;
+    const char *data = _placementBuilder.serialize(&size);
+
+    if(_firaClient->write(data, size) == -1){
+       Logger::error("REPLACER", "FiraClient failed to write to socket.");
+    }
+    else if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::REPLACER_PACKETS_SENT);
+    }
 }
 
 Constants* Replacer::getConstants() {
@@ -5,12 +5,39 @@
 #include <src/world/entities/vision/vision.h>
 #include <include/vssref_placement.pb.h>
 #include <include/packet.pb.h>
+#include <src/utils/spscqueue/spscqueue.h>
+#include <src/world/entities/replacer/replacercommand/replacercommand.h>
+#include <src/world/entities/replacer/placementbuilder/placementbuilder.h>
+#include <src/world/entities/replacer/placementtemplates/placementtemplates.h>
+#include <src/world/entities/replacer/placementvalidator/placementvalidator.h>
+
+#include <random>
 
 class Replacer : public Entity
 {
     Q_OBJECT
 public:
-    Replacer(Vision *vision, Constants *constants);
+    Replacer(Vision *vision, Constants *constants, Clock *clock);
+
+    // Lockstep (packets are kept to be sent with the next step)
+    void setLockstep(bool isLockstep);
+    fira_message::sim_to_ref::Packet takePendingPacket();
+
+    // Referee channel (commands are run at the Replacer loop, acks are taken by the Referee)
+    bool pushCommand(const ReplacerCommand &command);
+    bool takeAck(ReplacerAck *ack);
+
+    // Placement (run at the Replacer thread, through commands)
+    void takeFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant);
+    void placeTeams();
+    void placeOutside(VSSRef::Foul foul, VSSRef::Color oppositeTeam);
+    void saveFrameAndBall();
+    void placeLastFrameAndBall();
+    void placeBall(Position ballPos, Velocity ballVelocity = Velocity(true, 0.0, 0.0));
+
+    // Placement packets of teams (run at the Replacer thread, as read from the socket, late ones are taken after each batch)
+    bool takePlacementDatagram(const char *data, int size);
+    int takeLatePlacements();
 
 private:
     // Entity inherited methods
@@ -31,6 +58,29 @@ private:
     // Network management
     void bindAndConnect();
     void disconnectClient();
+    void sendPlacement();
+
+    // Placement ingest (socket drained in bounded batches, latest frame per team is kept)
+    static const int MAX_DATAGRAMS_PER_LOOP = 32;
+    static const int RECEIVE_BUFFER_SIZE = 64 * 1024;
+    QByteArray _datagramBuffer;
+    VSSRef::team_to_ref::VSSRef_Placement _placementPacket;
+    int receivePlacements();
+    bool takePlacement();
+    void setPlacement(VSSRef::Color teamColor, VSSRef::Frame *frame);
+    void dropPlacements(quint64 count, const char *reason);
+
+    // Lockstep pending packet
+    bool _isLockstep;
+    fira_message::sim_to_ref::Packet _pendingPacket;
+    ProfiledMutex _pendingMutex;
+
+    // Referee channel
+    SpscQueue<ReplacerCommand, 64> _commands;
+    SpscQueue<ReplacerAck, 64> _acks;
+    void processCommands();
+    void pushAck(const ReplacerAck &ack);
+    void takePlacementTargets(ReplacerAck *ack);
 
     // Vision
     Vision *_vision;
@@ -42,7 +92,7 @@ private:
     // Goalies management
     QHash<VSSRef::Color, quint8> _goalies;
     quint8 getGoalie(VSSRef::Color color);
-    QMutex _goalieMutex;
+    ProfiledMutex _goalieMutex;
 
     // Fouls management
     VSSRef::Foul _foul;
@@ -51,43 +101,39 @@ private:
     VSSRef::Foul getFoul();
     VSSRef::Color getFoulColor();
     VSSRef::Quadrant getFoulQuadrant();
-    QMutex _foulMutex;
+    ProfiledMutex _foulMutex;
     bool _foulProcessed;
+    quint64 _foulEpoch;
 
     // Placement management
     QHash<VSSRef::Color, VSSRef::Frame> _placement;
     QHash<VSSRef::Color, bool> _placementStatus;
+    QHash<VSSRef::Color, quint64> _placementEpoch;
+    QHash<VSSRef::Color, VSSRef::Frame> _latePlacement;
+    QHash<VSSRef::Color, bool> _latePlacementStatus;
+    bool _isTeamsPlacedAcked;
     bool _isGoaliePlacedAtTop;
-    void placeFrame(VSSRef::Frame frame);
+    PlacementBuilder _placementBuilder;
+    void placeFrame(const VSSRef::Frame &frame);
 
     // Last data (maintain ball stopped)
     Position _lastBallPosition;
     Velocity _lastBallVelocity;
     bool _placedLastPosition;
-    QHash<VSSRef::Color, QHash<quint8, fira_message::Robot*>*> _lastFrame;
-    QMutex _lastDataMutex;
-    void clearLastData();
+    VisionSnapshot _lastSnapshot;
+    bool _hasLastSnapshot;
+    ProfiledMutex _lastDataMutex;
 
     // Default placement utils
     Position getBallPlaceByFoul(VSSRef::Foul foul, VSSRef::Color color, VSSRef::Quadrant quadrant);
-    VSSRef::Frame getPenaltyPlacement(VSSRef::Color color);
-    VSSRef::Frame getGoalKickPlacement(VSSRef::Color color);
-    VSSRef::Frame getFreeBallPlacement(VSSRef::Color color);
-    VSSRef::Frame getKickoffPlacement(VSSRef::Color color);
-    VSSRef::Frame getOutsideFieldPlacement(VSSRef::Color color);
+    PlacementTemplates _placementTemplates;
+    std::mt19937 _goalieRandom;
+    void takeDefaultPlacement(PlacementTemplates::Formation formation, VSSRef::Color color, VSSRef::Frame *frame);
+    PlacementValidator _placementValidator;
     VSSRef::Frame getPenaltyShootoutPlacement(VSSRef::Color color, bool placeAttacker);
 
-signals:
-    void teamsPlaced();
-
 public slots:
     void takeGoalie(VSSRef::Color color, quint8 playerId);
-    void takeFoul(VSSRef::Foul foul, VSSRef::Color foulColor, VSSRef::Quadrant foulQuadrant);
-    void placeTeams();
-    void placeOutside(VSSRef::Foul foul, VSSRef::Color oppositeTeam);
-    void saveFrameAndBall();
-    void placeLastFrameAndBall();
-    void placeBall(Position ballPos, Velocity ballVelocity = Velocity(true, 0.0, 0.0));
 };
 
 #endif // REPLACER_H
@@ -0,0 +1,51 @@
+#ifndef REPLACERCOMMAND_H
+#define REPLACERCOMMAND_H
+
+#include <QtGlobal>
+
+#include <src/utils/types/position/position.h>
+#include <src/utils/types/velocity/velocity.h>
+#include <include/vssref_common.pb.h>
+
+// Command sent by the Referee, run at the Replacer thread
+struct ReplacerCommand {
+    enum Type {
+        TAKE_FOUL,
+        PLACE_TEAMS,
+        PLACE_OUTSIDE,
+        SAVE_FRAME,
+        PLACE_FRAME,
+        PLACE_BALL
+    };
+    Type type;
+    VSSRef::Foul foul;
+    VSSRef::Color teamColor;
+    VSSRef::Quadrant quadrant;
+    Position ballPosition;
+    Velocity ballVelocity;
+};
+
+// Robot position commanded by a placement
+struct PlacementTarget {
+    VSSRef::Color teamColor;
+    quint8 playerId;
+    float x;
+    float y;
+};
+
+// Answer of the Replacer to the Referee
+struct ReplacerAck {
+    enum Type {
+        COMMAND_DONE,
+        TEAMS_PLACED
+    };
+    Type type;
+    ReplacerCommand::Type command;
+
+    // Robots placed by the command (place teams and place outside)
+    static const int MAX_TARGETS = 16;
+    int targetsCount;
+    PlacementTarget targets[MAX_TARGETS];
+};
+
+#endif // REPLACERCOMMAND_H
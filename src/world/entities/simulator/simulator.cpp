@@ -0,0 +1,396 @@
+#include "simulator.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include <src/utils/types/field/field_default_3v3.h>
+
+namespace {
+    // Field dimensions (in meters)
+    const double kHalfLength = Field_Default_3v3::kFieldLength / 2000.0;
+    const double kHalfWidth = Field_Default_3v3::kFieldWidth / 2000.0;
+    const double kHalfGoalWidth = Field_Default_3v3::kGoalWidth / 2000.0;
+    const double kGoalDepth = Field_Default_3v3::kGoalDepth / 1000.0;
+
+    // Robot and ball physics
+    const double kWheelRadius = 0.025;
+    const double kBallDeceleration = 0.3;
+    const double kWallRestitution = 0.6;
+    const double kRobotRestitution = 0.4;
+}
+
+Simulator::Simulator(Constants *constants, Clock *clock) : Entity(ENT_SIMULATOR, clock) {
+    // Taking constants
+    _constants = constants;
+
+    // Taking network data
+    _visionAddress = getConstants()->visionAddress();
+    _visionPort = getConstants()->visionPort();
+    _firaPort = getConstants()->firaPort();
+    _visionServer = nullptr;
+
+    // Init simulation
+    _step = 0;
+    _goals[VSSRef::Color::BLUE] = 0;
+    _goals[VSSRef::Color::YELLOW] = 0;
+    _ballInsideGoal = false;
+    resetObjects();
+}
+
+void Simulator::initialization() {
+    // Simulator runs at its own frequency
+    setLoopFrequency(getConstants()->simulatorFrequency());
+
+    // Binding and connecting in network
+    bindAndConnect();
+
+    // Opening environment output
+    openPublisher();
+
+    std::cout << Text::blue("[SIMULATOR] ", true) + Text::bold("Module started at port '" + std::to_string(_firaPort) + "', sending environment to '" + _visionAddress.toStdString() + ":" + std::to_string(_visionPort) + "' at " + std::to_string(loopFrequency()) + " Hz.") + '\n';
+}
+
+void Simulator::loop() {
+    // Take packets sent by teams and replacer
+    while(_firaServer->hasPendingDatagrams()) {
+        fira_message::sim_to_ref::Packet packet;
+        QNetworkDatagram datagram;
+
+        // Reading datagram and checking if it is valid
+        datagram = _firaServer->receiveDatagram();
+        if(!datagram.isValid()) {
+            continue;
+        }
+
+        // Parsing datagram and checking if it worked properly
+        if(packet.ParseFromArray(datagram.data().data(), datagram.data().size()) == false) {
+            Logger::error("SIMULATOR", "Packet parsing error.");
+            continue;
+        }
+
+        processPacket(packet);
+    }
+
+    // Step simulation with a fixed dt, so runs are reproducible
+    step(1.0 / loopFrequency());
+
+    // Send environment to vision
+    fira_message::sim_to_ref::Environment environment;
+    buildEnvironment(&environment);
+    publishEnvironment(environment);
+}
+
+void Simulator::finalization() {
+    closePublisher();
+    disconnectClient();
+    std::cout << Text::blue("[SIMULATOR] ", true) + Text::bold("Module finished.") + '\n';
+}
+
+void Simulator::openPublisher() {
+    // Creating vision socket
+    _visionServer = new QUdpSocket();
+
+    // Creating vision ring (environment is sent by network if it fails)
+    if(getConstants()->useSharedMemory()) {
+        if(_visionRing.create(getConstants()->visionRing().toStdString(), ShmRing::PAYLOAD_ENVIRONMENT, getConstants()->ringSlots(), getConstants()->ringSlotSize())) {
+            std::cout << Text::blue("[SIMULATOR] ", true) + Text::bold("Writing environment to shared memory ring '" + getConstants()->visionRing().toStdString() + "'.") + '\n';
+        }
+    }
+}
+
+void Simulator::closePublisher() {
+    // Closing vision ring
+    _visionRing.close();
+
+    // Closing and deleting vision socket
+    if(_visionServer == nullptr) {
+        return ;
+    }
+
+    if(_visionServer->isOpen()) {
+        _visionServer->close();
+    }
+
+    delete _visionServer;
+    _visionServer = nullptr;
+}
+
+void Simulator::publishEnvironment(const fira_message::sim_to_ref::Environment &environment) {
+    // Serialized straight into the ring slot when vision is co-located
+    size_t environmentSize = environment.ByteSizeLong();
+    if(_visionRing.isOpen() && environmentSize <= _visionRing.slotSize()) {
+        environment.SerializeWithCachedSizesToArray(reinterpret_cast<quint8*>(_visionRing.beginWrite()));
+        _visionRing.endWrite(environmentSize);
+        return ;
+    }
+
+    if(_visionServer == nullptr) {
+        return ;
+    }
+
+    std::string msg;
+    environment.SerializeToString(&msg);
+    _visionServer->writeDatagram(msg.c_str(), msg.size(), QHostAddress(_visionAddress), _visionPort);
+}
+
+void Simulator::bindAndConnect() {
+    // Creating socket
+    _firaServer = new QUdpSocket();
+
+    // Binding fira server at the port replacer and teams send to
+    if(_firaServer->bind(QHostAddress::AnyIPv4, _firaPort, QUdpSocket::ShareAddress) == false) {
+        std::cout << Text::blue("[SIMULATOR] " , true) << Text::red("Error while binding socket.", true) + '\n';
+        return ;
+    }
+}
+
+void Simulator::disconnectClient() {
+    // Closing fira socket
+    if(_firaServer->isOpen()) {
+        _firaServer->close();
+    }
+
+    // Deleting socket
+    delete _firaServer;
+}
+
+void Simulator::resetObjects() {
+    // Ball at field center
+    _ball = {0.0, 0.0, 0.0, 0.0};
+
+    // Robots lined up at their own half
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        bool teamIsAtLeft = (i == VSSRef::Color::BLUE && getConstants()->blueIsLeftSide()) || (i == VSSRef::Color::YELLOW && !getConstants()->blueIsLeftSide());
+        double factor = (teamIsAtLeft) ? -1.0 : 1.0;
+
+        _robots[i].clear();
+        for(int j = 0; j < getConstants()->qtPlayers(); j++) {
+            SimRobot robot;
+            robot.x = factor * (0.2 + 0.2 * j);
+            robot.y = 0.3 - 0.3 * j;
+            robot.orientation = (teamIsAtLeft) ? 0.0 : M_PI;
+            robot.vx = robot.vy = robot.vorientation = 0.0;
+            robot.wheelLeft = robot.wheelRight = 0.0;
+            robot.isTurnedOn = true;
+
+            _robots[i].push_back(robot);
+        }
+    }
+}
+
+void Simulator::processPacket(const fira_message::sim_to_ref::Packet &packet) {
+    // Commands (wheel speeds in rad/s)
+    if(packet.has_cmd()) {
+        for(int i = 0; i < packet.cmd().robot_commands_size(); i++) {
+            const fira_message::sim_to_ref::Command &command = packet.cmd().robot_commands(i);
+            QVector<SimRobot> &team = _robots[command.yellowteam() ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE];
+            if(command.id() >= (quint32) team.size()) {
+                continue;
+            }
+
+            team[command.id()].wheelLeft = command.wheel_left();
+            team[command.id()].wheelRight = command.wheel_right();
+        }
+    }
+
+    // Replacements
+    if(packet.has_replace()) {
+        const fira_message::sim_to_ref::Replacement &replacement = packet.replace();
+
+        // Ball
+        if(replacement.has_ball()) {
+            _ball = {replacement.ball().x(), replacement.ball().y(), replacement.ball().vx(), replacement.ball().vy()};
+        }
+
+        // Robots (orientation comes in degrees)
+        for(int i = 0; i < replacement.robots_size(); i++) {
+            const fira_message::sim_to_ref::RobotReplacement &robotReplacement = replacement.robots(i);
+            QVector<SimRobot> &team = _robots[robotReplacement.yellowteam() ? VSSRef::Color::YELLOW : VSSRef::Color::BLUE];
+            const fira_message::Robot &position = robotReplacement.position();
+            if(position.robot_id() >= (quint32) team.size()) {
+                continue;
+            }
+
+            SimRobot &robot = team[position.robot_id()];
+            robot.x = position.x();
+            robot.y = position.y();
+            robot.orientation = position.orientation() * M_PI / 180.0;
+            robot.vx = robot.vy = robot.vorientation = 0.0;
+            robot.wheelLeft = robot.wheelRight = 0.0;
+            robot.isTurnedOn = robotReplacement.turnon();
+        }
+    }
+}
+
+void Simulator::step(double dt) {
+    stepRobots(dt);
+    stepBall(dt);
+    collideBallWithRobots();
+    checkGoal();
+
+    _step++;
+}
+
+void Simulator::simulate(const fira_message::sim_to_ref::Packet &packet, fira_message::sim_to_ref::Environment *environment, double dt) {
+    processPacket(packet);
+    step(dt);
+    buildEnvironment(environment);
+}
+
+void Simulator::stepRobots(double dt) {
+    const double axisLength = getConstants()->robotLength();
+    const double halfRobot = getConstants()->robotLength() / 2.0;
+
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < _robots[i].size(); j++) {
+            SimRobot &robot = _robots[i][j];
+
+            // Turned off robots stay stopped
+            if(!robot.isTurnedOn) {
+                robot.vx = robot.vy = robot.vorientation = 0.0;
+                continue;
+            }
+
+            // Differential drive kinematics
+            double linear = kWheelRadius * (robot.wheelLeft + robot.wheelRight) / 2.0;
+            robot.vorientation = kWheelRadius * (robot.wheelRight - robot.wheelLeft) / axisLength;
+            robot.orientation = remainder(robot.orientation + robot.vorientation * dt, 2.0 * M_PI);
+            robot.vx = linear * cos(robot.orientation);
+            robot.vy = linear * sin(robot.orientation);
+
+            // Robots placed out of the field (by replacer) are not bounded by walls
+            bool wasInsideField = (fabs(robot.x) <= kHalfLength + kGoalDepth && fabs(robot.y) <= kHalfWidth);
+
+            robot.x += robot.vx * dt;
+            robot.y += robot.vy * dt;
+
+            // Walls
+            if(wasInsideField) {
+                double maxX = (fabs(robot.y) < kHalfGoalWidth - halfRobot) ? kHalfLength + kGoalDepth - halfRobot : kHalfLength - halfRobot;
+                robot.x = std::max(-maxX, std::min(maxX, robot.x));
+                robot.y = std::max(-(kHalfWidth - halfRobot), std::min(kHalfWidth - halfRobot, robot.y));
+            }
+        }
+    }
+}
+
+void Simulator::stepBall(double dt) {
+    const double ballRadius = getConstants()->ballRadius();
+
+    // Rolling friction
+    double speed = sqrt(pow(_ball.vx, 2) + pow(_ball.vy, 2));
+    if(speed > 0.0) {
+        double newSpeed = std::max(0.0, speed - kBallDeceleration * dt);
+        _ball.vx *= newSpeed / speed;
+        _ball.vy *= newSpeed / speed;
+    }
+
+    _ball.x += _ball.vx * dt;
+    _ball.y += _ball.vy * dt;
+
+    // Side walls
+    if(fabs(_ball.y) > kHalfWidth - ballRadius) {
+        _ball.y = copysign(kHalfWidth - ballRadius, _ball.y);
+        _ball.vy = -_ball.vy * kWallRestitution;
+    }
+
+    // Goal lines (open at goal mouth, closed at goal back)
+    bool atGoalMouth = (fabs(_ball.y) < kHalfGoalWidth - ballRadius);
+    double maxX = (atGoalMouth) ? kHalfLength + kGoalDepth - ballRadius : kHalfLength - ballRadius;
+    if(fabs(_ball.x) > maxX) {
+        _ball.x = copysign(maxX, _ball.x);
+        _ball.vx = -_ball.vx * kWallRestitution;
+    }
+}
+
+void Simulator::collideBallWithRobots() {
+    const double minDistance = getConstants()->ballRadius() + getConstants()->robotLength() / 2.0;
+
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < _robots[i].size(); j++) {
+            const SimRobot &robot = _robots[i].at(j);
+
+            // Check contact
+            double dx = _ball.x - robot.x;
+            double dy = _ball.y - robot.y;
+            double distance = sqrt(pow(dx, 2) + pow(dy, 2));
+            if(distance >= minDistance || distance <= 0.0) {
+                continue;
+            }
+
+            // Push ball out of robot
+            double nx = dx / distance;
+            double ny = dy / distance;
+            _ball.x = robot.x + nx * minDistance;
+            _ball.y = robot.y + ny * minDistance;
+
+            // Bounce ball using relative velocity along contact normal
+            double relativeNormal = (_ball.vx - robot.vx) * nx + (_ball.vy - robot.vy) * ny;
+            if(relativeNormal < 0.0) {
+                _ball.vx -= (1.0 + kRobotRestitution) * relativeNormal * nx;
+                _ball.vy -= (1.0 + kRobotRestitution) * relativeNormal * ny;
+            }
+        }
+    }
+}
+
+void Simulator::checkGoal() {
+    // Ball is inside goal when it fully crossed the goal line
+    bool ballInsideGoal = (fabs(_ball.x) > kHalfLength + getConstants()->ballRadius() && fabs(_ball.y) < kHalfGoalWidth);
+
+    // Count goal only when ball enters (referee handles the replacement)
+    if(ballInsideGoal && !_ballInsideGoal) {
+        bool isLeftGoal = (_ball.x < 0.0);
+        bool blueScored = (isLeftGoal != getConstants()->blueIsLeftSide());
+        _goals[blueScored ? VSSRef::Color::BLUE : VSSRef::Color::YELLOW]++;
+    }
+
+    _ballInsideGoal = ballInsideGoal;
+}
+
+void Simulator::buildEnvironment(fira_message::sim_to_ref::Environment *environment) {
+    environment->set_step(_step);
+    environment->set_goals_blue(_goals[VSSRef::Color::BLUE]);
+    environment->set_goals_yellow(_goals[VSSRef::Color::YELLOW]);
+
+    // Field
+    fira_message::Field *field = environment->mutable_field();
+    field->set_length(2.0 * kHalfLength);
+    field->set_width(2.0 * kHalfWidth);
+    field->set_goal_width(2.0 * kHalfGoalWidth);
+    field->set_goal_depth(kGoalDepth);
+
+    // Ball
+    fira_message::Frame *frame = environment->mutable_frame();
+    fira_message::Ball *ball = frame->mutable_ball();
+    ball->set_x(_ball.x);
+    ball->set_y(_ball.y);
+    ball->set_vx(_ball.vx);
+    ball->set_vy(_ball.vy);
+
+    // Robots
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < _robots[i].size(); j++) {
+            const SimRobot &simRobot = _robots[i].at(j);
+            fira_message::Robot *robot = (i == VSSRef::Color::BLUE) ? frame->add_robots_blue() : frame->add_robots_yellow();
+            robot->set_robot_id(j);
+            robot->set_x(simRobot.x);
+            robot->set_y(simRobot.y);
+            robot->set_orientation(simRobot.orientation);
+            robot->set_vx(simRobot.vx);
+            robot->set_vy(simRobot.vy);
+            robot->set_vorientation(simRobot.vorientation);
+        }
+    }
+}
+
+Constants* Simulator::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at Simulator") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,81 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+#include <QVector>
+
+#include <src/world/entities/entity.h>
+#include <src/constants/constants.h>
+#include <include/vssref_common.pb.h>
+#include <include/packet.pb.h>
+#include <src/utils/shmring/shmring.h>
+
+class Simulator : public Entity
+{
+public:
+    Simulator(Constants *constants, Clock *clock);
+
+    // Simulation control
+    void processPacket(const fira_message::sim_to_ref::Packet &packet);
+    void step(double dt);
+    void buildEnvironment(fira_message::sim_to_ref::Environment *environment);
+
+    // Simulate rpc semantics (apply packet, step and take environment)
+    void simulate(const fira_message::sim_to_ref::Packet &packet, fira_message::sim_to_ref::Environment *environment, double dt);
+
+    // Environment output (to vision address and port, or to the vision ring)
+    void openPublisher();
+    void closePublisher();
+    void publishEnvironment(const fira_message::sim_to_ref::Environment &environment);
+
+private:
+    // Entity inherited methods
+    void initialization();
+    void loop();
+    void finalization();
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Network (receives packets at fira port and sends environment to vision)
+    QUdpSocket *_firaServer;
+    QUdpSocket *_visionServer;
+    QString _visionAddress;
+    quint16 _visionPort;
+    quint16 _firaPort;
+    void bindAndConnect();
+    void disconnectClient();
+
+    // Shared memory ring to send environment to a co-located vision
+    ShmRing _visionRing;
+
+    // Simulated objects
+    struct SimBall {
+        double x, y;
+        double vx, vy;
+    };
+    struct SimRobot {
+        double x, y, orientation;
+        double vx, vy, vorientation;
+        double wheelLeft, wheelRight;
+        bool isTurnedOn;
+    };
+    SimBall _ball;
+    QVector<SimRobot> _robots[2];
+    void resetObjects();
+
+    // Simulation state
+    quint32 _step;
+    quint32 _goals[2];
+    bool _ballInsideGoal;
+
+    // Physics
+    void stepRobots(double dt);
+    void stepBall(double dt);
+    void collideBallWithRobots();
+    void checkGoal();
+};
+
+#endif // SIMULATOR_H
@@ -0,0 +1,133 @@
+#include "statebroadcaster.h"
+
+StateBroadcaster::StateBroadcaster(Vision *vision, Constants *constants, Clock *clock) : Entity(ENT_BROADCAST, clock) {
+    // Take pointers
+    _vision = vision;
+    _constants = constants;
+
+    // Taking network data
+    _broadcastAddress = getConstants()->broadcastAddress();
+    _broadcastPort = getConstants()->broadcastPort();
+    _useStateBroadcast = getConstants()->useStateBroadcast();
+    _broadcastClient = nullptr;
+
+    // Key frames interval
+    _encoder.setKeyFrameInterval(getConstants()->keyFrameInterval());
+
+    // No frame sent yet
+    _lastFrameCount = 0;
+    _sentFrames = 0;
+    _sentKeyFrames = 0;
+    _sentBytes = 0;
+}
+
+void StateBroadcaster::initialization() {
+    // Connect
+    if(_useStateBroadcast) {
+        connectClient();
+
+        // Debug network info
+        std::cout << Text::blue("[BROADCAST] ", true) + Text::bold("Module started at address '" + _broadcastAddress.toStdString() + "' and port '" + std::to_string(_broadcastPort) + "'.") + '\n';
+    }
+
+    // Create state ring
+    if(getConstants()->useSharedMemory()) {
+        if(sizeof(VisionSnapshot) > static_cast<size_t>(getConstants()->ringSlotSize())) {
+            std::cout << Text::blue("[BROADCAST] ", true) << Text::red("Ring slot size is smaller than a snapshot (" + std::to_string(sizeof(VisionSnapshot)) + " bytes).", true) + '\n';
+        }
+        else if(_stateRing.create(getConstants()->stateRing().toStdString(), ShmRing::PAYLOAD_VISION_SNAPSHOT, getConstants()->ringSlots(), getConstants()->ringSlotSize())) {
+            std::cout << Text::blue("[BROADCAST] ", true) + Text::bold("Module writing to shared memory ring '" + getConstants()->stateRing().toStdString() + "'.") + '\n';
+        }
+    }
+}
+
+void StateBroadcaster::loop() {
+    // Idle until the next vision frame (runs at the vision rate, not at the loop frequency)
+    idleFor(getConstants()->idleTime() * 1000, true);
+
+    // Take filtered state in a single vision read
+    _vision->takeSnapshot(&_snapshot);
+
+    // Send each published frame once
+    if(_snapshot.frameCount == _lastFrameCount) {
+        return ;
+    }
+    _lastFrameCount = _snapshot.frameCount;
+
+    // Snapshot is copied as it is into the ring (readers share this build layout)
+    if(_stateRing.isOpen()) {
+        _stateRing.write(reinterpret_cast<const char*>(&_snapshot), sizeof(VisionSnapshot));
+    }
+
+    if(_broadcastClient != nullptr) {
+        sendDatagram();
+    }
+}
+
+bool StateBroadcaster::sendDatagram() {
+    // Encode (delta to the last sent frame) and send via socket
+    bool isKeyFrame = _encoder.encode(_snapshot, getClock()->getSeconds(), &_datagram);
+    if(_broadcastClient->write(_datagram.c_str(), static_cast<quint64>(_datagram.length())) == -1) {
+        Logger::error("BROADCAST", "Failed to write to socket.");
+
+        // Receivers can not apply the next delta
+        _encoder.reset();
+        return false;
+    }
+
+    _sentFrames++;
+    _sentKeyFrames += (isKeyFrame) ? 1 : 0;
+    _sentBytes += _datagram.length();
+
+    if(getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::BROADCAST_FRAMES_SENT);
+        getMetrics()->increment(Metrics::BROADCAST_BYTES_SENT, _datagram.length());
+    }
+
+    return true;
+}
+
+void StateBroadcaster::finalization() {
+    // Disconnect client
+    disconnectClient();
+
+    // Report sent data
+    if(_sentFrames > 0) {
+        std::cout << Text::blue("[BROADCAST] ", true) + Text::bold("Sent " + std::to_string(_sentFrames) + " frames (" + std::to_string(_sentKeyFrames) + " key frames), " + std::to_string(_sentBytes / _sentFrames) + " bytes per frame.") + '\n';
+    }
+
+    std::cout << Text::blue("[BROADCAST] ", true) + Text::bold("Module finished.") + '\n';
+}
+
+void StateBroadcaster::connectClient() {
+    // Create socket pointer
+    _broadcastClient = new QUdpSocket();
+
+    // Connect to broadcast address and port
+    _broadcastClient->connectToHost(_broadcastAddress, _broadcastPort, QIODevice::WriteOnly, QAbstractSocket::IPv4Protocol);
+}
+
+void StateBroadcaster::disconnectClient() {
+    // Close broadcast client
+    if(_broadcastClient != nullptr && _broadcastClient->isOpen()) {
+        _broadcastClient->close();
+    }
+
+    // Delete client
+    delete _broadcastClient;
+    _broadcastClient = nullptr;
+
+    // Close state ring
+    _stateRing.close();
+}
+
+Constants* StateBroadcaster::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at StateBroadcaster") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
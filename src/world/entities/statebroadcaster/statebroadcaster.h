@@ -0,0 +1,54 @@
+#ifndef STATEBROADCASTER_H
+#define STATEBROADCASTER_H
+
+#include <QUdpSocket>
+
+#include <src/world/entities/entity.h>
+#include <src/world/entities/vision/vision.h>
+#include <src/world/entities/statebroadcaster/worldstateencoder/worldstateencoder.h>
+#include <src/utils/shmring/shmring.h>
+
+// Sends the filtered Vision state to multicast and to the state ring, once per vision frame
+class StateBroadcaster : public Entity
+{
+public:
+    StateBroadcaster(Vision *vision, Constants *constants, Clock *clock);
+
+private:
+    // Entity inherited methods
+    void initialization();
+    void loop();
+    void finalization();
+
+    // Vision
+    Vision *_vision;
+
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Broadcast client
+    QUdpSocket *_broadcastClient;
+    QString _broadcastAddress;
+    quint16 _broadcastPort;
+    bool _useStateBroadcast;
+    void connectClient();
+    void disconnectClient();
+    bool sendDatagram();
+
+    // State ring (snapshots written as they are, for co-located teams)
+    ShmRing _stateRing;
+
+    // World state (snapshot, encoder and datagram memory are reused)
+    VisionSnapshot _snapshot;
+    WorldStateEncoder _encoder;
+    std::string _datagram;
+    quint64 _lastFrameCount;
+
+    // Sent data
+    quint64 _sentFrames;
+    quint64 _sentKeyFrames;
+    quint64 _sentBytes;
+};
+
+#endif // STATEBROADCASTER_H
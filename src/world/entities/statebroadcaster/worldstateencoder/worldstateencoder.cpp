@@ -0,0 +1,113 @@
+#include "worldstateencoder.h"
+
+#include <algorithm>
+#include <cmath>
+
+const WorldStateEncoder::ObjectState WorldStateEncoder::ZERO_STATE = {false, 0, 0, 0, 0, 0};
+
+WorldStateEncoder::WorldStateEncoder() {
+    // Key frame every 30 frames by default
+    _keyFrameInterval = 30;
+
+    reset();
+}
+
+void WorldStateEncoder::setKeyFrameInterval(int keyFrameInterval) {
+    _keyFrameInterval = std::max(1, keyFrameInterval);
+}
+
+void WorldStateEncoder::reset() {
+    // Next frame is a key frame
+    _lastFrameId = 0;
+    _framesSinceKeyFrame = 0;
+
+    _lastBall = ZERO_STATE;
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < VisionSnapshot::MAX_PLAYERS; j++) {
+            _lastRobots[i][j] = ZERO_STATE;
+        }
+    }
+}
+
+bool WorldStateEncoder::encode(const VisionSnapshot &snapshot, double timestamp, std::string *datagram) {
+    bool isKeyFrame = (_lastFrameId == 0 || _framesSinceKeyFrame >= _keyFrameInterval);
+
+    // Frame info
+    _worldState.Clear();
+    _worldState.set_frameid(snapshot.frameCount);
+    _worldState.set_baseframeid(isKeyFrame ? 0 : _lastFrameId);
+    _worldState.set_timestamp(timestamp);
+
+    // Ball
+    ObjectState ball = ZERO_STATE;
+    if(snapshot.isBallValid) {
+        ball = {true, quantize(snapshot.ballX), quantize(snapshot.ballY), 0, quantize(snapshot.ballVx), quantize(snapshot.ballVy)};
+    }
+
+    // Key frames take valid objects (from zero), delta frames take changed ones
+    const ObjectState &ballBase = isKeyFrame ? ZERO_STATE : _lastBall;
+    if((isKeyFrame && ball.isValid) || (!isKeyFrame && isChanged(ball, _lastBall))) {
+        VSSRef::ref_to_team::WorldState_Ball *ballState = _worldState.mutable_ball();
+        ballState->set_isvalid(ball.isValid);
+        if(ball.isValid) {
+            ballState->set_x(ball.x - ballBase.x);
+            ballState->set_y(ball.y - ballBase.y);
+            ballState->set_vx(ball.vx - ballBase.vx);
+            ballState->set_vy(ball.vy - ballBase.vy);
+        }
+    }
+    _lastBall = ball;
+
+    // Robots (indexed by id, players out of range are not sent)
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        for(int j = 0; j < VisionSnapshot::MAX_PLAYERS; j++) {
+            _robots[i][j] = ZERO_STATE;
+        }
+
+        const VisionSnapshot::Team &team = snapshot.teams[i];
+        for(int j = 0; j < team.playersCount; j++) {
+            const VisionSnapshot::Player &player = team.players[j];
+            if(player.playerId < VisionSnapshot::MAX_PLAYERS) {
+                _robots[i][player.playerId] = {true, quantize(player.x), quantize(player.y), quantize(player.orientation), quantize(player.vx), quantize(player.vy)};
+            }
+        }
+
+        for(int j = 0; j < VisionSnapshot::MAX_PLAYERS; j++) {
+            const ObjectState &robot = _robots[i][j];
+            const ObjectState &robotBase = isKeyFrame ? ZERO_STATE : _lastRobots[i][j];
+            if((isKeyFrame && robot.isValid) || (!isKeyFrame && isChanged(robot, _lastRobots[i][j]))) {
+                VSSRef::ref_to_team::WorldState_Robot *robotState = _worldState.add_robots();
+                robotState->set_teamcolor(VSSRef::Color(i));
+                robotState->set_robotid(j);
+                robotState->set_isvalid(robot.isValid);
+                if(robot.isValid) {
+                    robotState->set_x(robot.x - robotBase.x);
+                    robotState->set_y(robot.y - robotBase.y);
+                    robotState->set_orientation(robot.orientation - robotBase.orientation);
+                    robotState->set_vx(robot.vx - robotBase.vx);
+                    robotState->set_vy(robot.vy - robotBase.vy);
+                }
+            }
+            _lastRobots[i][j] = robot;
+        }
+    }
+
+    // Serialize (datagram memory is reused by the caller)
+    datagram->clear();
+    _worldState.SerializeToString(datagram);
+
+    // Update last frame
+    _lastFrameId = snapshot.frameCount;
+    _framesSinceKeyFrame = (isKeyFrame) ? 1 : (_framesSinceKeyFrame + 1);
+
+    return isKeyFrame;
+}
+
+bool WorldStateEncoder::isChanged(const ObjectState &state, const ObjectState &lastState) {
+    return (state.isValid != lastState.isValid || state.x != lastState.x || state.y != lastState.y || state.orientation != lastState.orientation || state.vx != lastState.vx || state.vy != lastState.vy);
+}
+
+qint32 WorldStateEncoder::quantize(float value) {
+    // Meters (and radians) to thousandths
+    return static_cast<qint32>(std::lround(value * 1000.0f));
+}
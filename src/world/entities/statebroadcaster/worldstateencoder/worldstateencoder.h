@@ -0,0 +1,52 @@
+#ifndef WORLDSTATEENCODER_H
+#define WORLDSTATEENCODER_H
+
+#include <QtGlobal>
+
+#include <string>
+
+#include <include/vssref_worldstate.pb.h>
+#include <src/world/entities/vision/visionsnapshot/visionsnapshot.h>
+
+// Encodes vision snapshots as quantized world states, as deltas to the last encoded one
+class WorldStateEncoder
+{
+public:
+    WorldStateEncoder();
+
+    // Key frames (sent every interval, so receivers that lost a frame recover)
+    void setKeyFrameInterval(int keyFrameInterval);
+    void reset();
+
+    // Encode snapshot into datagram (returns if it is a key frame)
+    bool encode(const VisionSnapshot &snapshot, double timestamp, std::string *datagram);
+
+private:
+    // Quantized object (invalid objects are kept as zero)
+    struct ObjectState {
+        bool isValid;
+        qint32 x;
+        qint32 y;
+        qint32 orientation;
+        qint32 vx;
+        qint32 vy;
+    };
+    static const ObjectState ZERO_STATE;
+    static bool isChanged(const ObjectState &state, const ObjectState &lastState);
+    static qint32 quantize(float value);
+
+    // Last encoded frame
+    ObjectState _lastBall;
+    ObjectState _lastRobots[2][VisionSnapshot::MAX_PLAYERS];
+    ObjectState _robots[2][VisionSnapshot::MAX_PLAYERS];
+    quint64 _lastFrameId;
+
+    // Key frames
+    int _keyFrameInterval;
+    int _framesSinceKeyFrame;
+
+    // Message (memory reused between frames)
+    VSSRef::ref_to_team::VSSRef_WorldState _worldState;
+};
+
+#endif // WORLDSTATEENCODER_H
@@ -4,7 +4,7 @@ QString KalmanFilter::name() {
     return "KalmanFilter";
 }
 
-KalmanFilter::KalmanFilter() {
+KalmanFilter::KalmanFilter(Clock *clock) : _timer(clock) {
     _has1stPosition = _has2ndPosition = false;
 
     // Initialize state matrices
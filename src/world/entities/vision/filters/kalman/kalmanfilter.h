@@ -35,7 +35,7 @@ private:
     bool enabled;
 
 public:
-    KalmanFilter();
+    KalmanFilter(Clock *clock = nullptr);
 
     QString name();
     void iterate(const Position &pos);
@@ -1,9 +1,8 @@
 #include "lossfilter.h"
 
-float LossFilter::_filterTime = 300;
-
-LossFilter::LossFilter() {
+LossFilter::LossFilter(float lossTime, Clock *clock) : _timer(clock) {
     _isInitialized = false;
+    _filterTime = lossTime;
 }
 
 void LossFilter::startLoss() {
@@ -6,7 +6,7 @@
 class LossFilter
 {
 public:
-    LossFilter();
+    LossFilter(float lossTime = 300, Clock *clock = nullptr);
 
     // Noise control
     void startLoss();
@@ -17,14 +17,14 @@ public:
     float getLossTime();
 
     // Setters
-    static void setLossTime(float lossTime);
+    void setLossTime(float lossTime);
 private:
     // Timer
     Timer _timer;
 
     // Params
     bool _isInitialized;
-    static float _filterTime;
+    float _filterTime;
 };
 
 #endif // LOSSFILTER_H
@@ -1,9 +1,8 @@
 #include "noisefilter.h"
 
-float NoiseFilter::_filterTime = 300;
-
-NoiseFilter::NoiseFilter() {
+NoiseFilter::NoiseFilter(float noiseTime, Clock *clock) : _timer(clock) {
     _isInitialized = false;
+    _filterTime = noiseTime;
 }
 
 void NoiseFilter::startNoise() {
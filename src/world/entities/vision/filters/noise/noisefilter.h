@@ -6,7 +6,7 @@
 class NoiseFilter
 {
 public:
-    NoiseFilter();
+    NoiseFilter(float noiseTime = 300, Clock *clock = nullptr);
 
     // Noise control
     void startNoise();
@@ -17,7 +17,7 @@ public:
     float getNoiseTime();
 
     // Setters
-    static void setNoiseTime(float noiseTime);
+    void setNoiseTime(float noiseTime);
 
 private:
     // Timer
@@ -25,7 +25,7 @@ private:
 
     // Params
     bool _isInitialized;
-    static float _filterTime;
+    float _filterTime;
 };
 
 #endif // NOISEFILTER_H
@@ -1,17 +1,23 @@
 #include "vision.h"
 
-#include <include/packet.pb.h>
-
-Vision::Vision(Constants *constants) : Entity(ENT_VISION) {
+Vision::Vision(Constants *constants, Clock *clock) : Entity(ENT_VISION, clock), _dataMutex("Vision::dataMutex") {
     // Taking constants
     _constants = constants;
 
     // Taking network data
     _visionAddress = getConstants()->visionAddress();
     _visionPort = getConstants()->visionPort();
+    _useSharedMemory = getConstants()->useSharedMemory();
+    _visionClient = nullptr;
 
     // Init objects
     initObjects();
+
+    // Latency tracing is disabled by default
+    _latencyTracker = nullptr;
+
+    // No frames published yet
+    _frameCount = 0;
 }
 
 Vision::~Vision() {
@@ -19,13 +25,36 @@ Vision::~Vision() {
 }
 
 void Vision::initialization() {
+    // Frames come from the shared memory ring instead of the network
+    if(_useSharedMemory) {
+        std::cout << Text::blue("[VISION] ", true) + Text::bold("Module started at shared memory ring '" + getConstants()->visionRing().toStdString() + "'.") + '\n';
+        return ;
+    }
+
     // Binding and connecting in network
     bindAndConnect();
 
+    // Wake up when frames arrive (instead of at the next loop period)
+    if(getNetworkReactor() != nullptr) {
+        getNetworkReactor()->addSocket(_visionClient, this);
+    }
+
     std::cout << Text::blue("[VISION] ", true) + Text::bold("Module started at address '" + _visionAddress.toStdString() + "' and port '" + std::to_string(_visionPort) + "'.") + '\n';
 }
 
 void Vision::loop() {
+    // Receive frames from the co-located simulator ring or from the network
+    int processedFrames = (_useSharedMemory) ? receiveFromRing() : receiveDatagrams();
+
+    // Frames replaced by a newer one in the same loop
+    if(processedFrames > 1 && getMetrics() != nullptr) {
+        getMetrics()->increment(Metrics::VISION_FRAMES_COALESCED, processedFrames - 1);
+    }
+}
+
+int Vision::receiveDatagrams() {
+    int processedFrames = 0;
+
     while(_visionClient->hasPendingDatagrams()) {
         // Creating auxiliary vars
         fira_message::sim_to_ref::Environment environmentData;
@@ -37,101 +66,244 @@ void Vision::loop() {
             continue;
         }
 
+        if(getMetrics() != nullptr) {
+            getMetrics()->increment(Metrics::VISION_DATAGRAMS_RECEIVED);
+        }
+
+        // Start frame trace at arrival
+        quint64 traceId = 0;
+        if(_latencyTracker != nullptr) {
+            traceId = _latencyTracker->beginFrame();
+        }
+
         // Parsing datagram and checking if it worked properly
-        if(environmentData.ParseFromArray(datagram.data().data(), datagram.data().size()) == false) {
-            std::cout << Text::blue("[VISION] ", true) << Text::red("Wrapper packet parsing error.", true) + '\n';
+        TraceSpan parseSpan("Vision::parse", "vision");
+        bool isParsed = environmentData.ParseFromArray(datagram.data().data(), datagram.data().size());
+        parseSpan.finish();
+
+        if(isParsed == false) {
+            Logger::error("VISION", "Wrapper packet parsing error.");
+            if(getMetrics() != nullptr) {
+                getMetrics()->increment(Metrics::VISION_PARSE_ERRORS);
+            }
             continue;
         }
 
-        // Iterate received vision frame
-        if(environmentData.has_frame()) {
-            // Lock mutex for write
-            _dataMutex.lockForWrite();
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->markDecoded(traceId);
+        }
 
-            // Clear objects control
-            clearObjectsControl();
+        // Process received environment
+        processEnvironment(environmentData, traceId);
+        processedFrames++;
+    }
 
-            // Take frame
-            fira_message::Frame frame = environmentData.frame();
+    return processedFrames;
+}
 
-            // Parse ball
-            if(frame.has_ball()) {
-                _ballObject->updateObject(1.0f, Position(true, frame.ball().x(), frame.ball().y()));
-            }
-            else {
-                _ballObject->updateObject(0.0f, Position(false, 0.0, 0.0));
+int Vision::receiveFromRing() {
+    // Attach to ring (the simulator may start after the referee)
+    if(!_visionRing.isOpen() && !_visionRing.attach(getConstants()->visionRing().toStdString(), ShmRing::PAYLOAD_ENVIRONMENT)) {
+        return 0;
+    }
+
+    int processedFrames = 0;
+    quint32 size = 0;
+    const char *data = nullptr;
+
+    while((data = _visionRing.peek(&size)) != nullptr) {
+        if(getMetrics() != nullptr) {
+            getMetrics()->increment(Metrics::VISION_DATAGRAMS_RECEIVED);
+        }
+
+        // Start frame trace at arrival
+        quint64 traceId = 0;
+        if(_latencyTracker != nullptr) {
+            traceId = _latencyTracker->beginFrame();
+        }
+
+        // Parsing straight from the slot, discarded if the producer overwrote it meanwhile
+        TraceSpan parseSpan("Vision::parse", "vision");
+        bool isParsed = _ringEnvironment.ParseFromArray(data, size);
+        bool isValid = _visionRing.commit();
+        parseSpan.finish();
+
+        if(!isValid) {
+            continue;
+        }
+
+        if(isParsed == false) {
+            Logger::error("VISION", "Ring environment parsing error.");
+            if(getMetrics() != nullptr) {
+                getMetrics()->increment(Metrics::VISION_PARSE_ERRORS);
             }
+            continue;
+        }
+
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->markDecoded(traceId);
+        }
 
-            // Parse blue robots
-            for(int i = 0; i < frame.robots_blue_size(); i++) {
-                // Take robot
-                fira_message::Robot robot = frame.robots_blue(i);
+        // Process received environment
+        processEnvironment(_ringEnvironment, traceId);
+        processedFrames++;
+    }
 
-                // Take id
-                quint8 robotId = robot.robot_id();
+    // Producer finished, attach again to the next one
+    if(_visionRing.isProducerClosed()) {
+        Logger::info("VISION", "Vision ring closed by the simulator, waiting for a new one.");
+        _visionRing.close();
+    }
+
+    return processedFrames;
+}
+
+void Vision::processEnvironment(const fira_message::sim_to_ref::Environment &environmentData, quint64 traceId) {
+    // Iterate received vision frame
+    if(environmentData.has_frame()) {
+        TraceSpan processSpan("Vision::processEnvironment", "vision");
+
+        // Frames fed without a datagram (lockstep) start their trace here
+        if(_latencyTracker != nullptr && traceId == 0) {
+            traceId = _latencyTracker->beginFrame();
+            _latencyTracker->markDecoded(traceId);
+        }
 
-                // Get object
-                Object *robotObject = _objects.value(VSSRef::Color::BLUE)->value(robotId);
-                robotObject->updateObject(1.0f, Position(true, robot.x(), robot.y()), Angle(true, robot.orientation()));
+        // Lock mutex for write (wait shows readers contention)
+        TraceSpan lockSpan("Vision::lockForWrite", "lock");
+        _dataMutex.lockForWrite();
+        lockSpan.finish();
 
-                // Update control to true
-                _objectsControl.value(VSSRef::Color::BLUE)->insert(robotId, true);
+        // Clear objects control
+        clearObjectsControl();
+
+        // Take frame
+        fira_message::Frame frame = environmentData.frame();
+
+        // Parse ball
+        if(frame.has_ball()) {
+            _ballObject->updateObject(1.0f, Position(true, frame.ball().x(), frame.ball().y()));
+        }
+        else {
+            bool wasValid = !_ballObject->getPosition().isInvalid();
+            _ballObject->updateObject(0.0f, Position(false, 0.0, 0.0));
+
+            if(wasValid && _ballObject->getPosition().isInvalid() && getMetrics() != nullptr) {
+                getMetrics()->incrementBallLoss();
             }
+        }
 
-            // Parse yellow robots
-            for(int i = 0; i < frame.robots_yellow_size(); i++) {
-                // Take robot
-                fira_message::Robot robot = frame.robots_yellow(i);
+        // Parse blue robots
+        for(int i = 0; i < frame.robots_blue_size(); i++) {
+            // Take robot
+            fira_message::Robot robot = frame.robots_blue(i);
 
-                // Take id
-                quint8 robotId = robot.robot_id();
+            // Take id
+            quint8 robotId = robot.robot_id();
 
-                // Get object
-                Object *robotObject = _objects.value(VSSRef::Color::YELLOW)->value(robotId);
-                robotObject->updateObject(1.0f, Position(true, robot.x(), robot.y()), Angle(true, robot.orientation()));
+            // Get object (ignore ids out of the registered players)
+            Object *robotObject = _objects.value(VSSRef::Color::BLUE)->value(robotId, nullptr);
+            if(robotObject == nullptr) {
+                continue;
+            }
+            robotObject->updateObject(1.0f, Position(true, robot.x(), robot.y()), Angle(true, robot.orientation()));
 
-                // Update control to true
-                _objectsControl.value(VSSRef::Color::YELLOW)->insert(robotId, true);
+            // Update control to true
+            _objectsControl.value(VSSRef::Color::BLUE)->insert(robotId, true);
+        }
+
+        // Parse yellow robots
+        for(int i = 0; i < frame.robots_yellow_size(); i++) {
+            // Take robot
+            fira_message::Robot robot = frame.robots_yellow(i);
+
+            // Take id
+            quint8 robotId = robot.robot_id();
+
+            // Get object (ignore ids out of the registered players)
+            Object *robotObject = _objects.value(VSSRef::Color::YELLOW)->value(robotId, nullptr);
+            if(robotObject == nullptr) {
+                continue;
             }
+            robotObject->updateObject(1.0f, Position(true, robot.x(), robot.y()), Angle(true, robot.orientation()));
+
+            // Update control to true
+            _objectsControl.value(VSSRef::Color::YELLOW)->insert(robotId, true);
+        }
+
+        // Parse robots that didn't appeared
+        for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+            // Take control hash
+            QHash<quint8, bool> *idsControl = _objectsControl.value(VSSRef::Color(i));
 
-            // Parse robots that didn't appeared
-            for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
-                // Take control hash
-                QHash<quint8, bool> *idsControl = _objectsControl.value(VSSRef::Color(i));
+            // Take ids list and iterate on it
+            QList<quint8> idList = idsControl->keys();
+            QList<quint8>::iterator it;
 
-                // Take ids list and iterate on it
-                QList<quint8> idList = idsControl->keys();
-                QList<quint8>::iterator it;
+            for(it = idList.begin(); it != idList.end(); it++) {
+                // If not updated (== false)
+                if(idsControl->value((*it)) == false) {
+                    // Take object
+                    Object *robotObject = _objects.value(VSSRef::Color(i))->value((*it));
 
-                for(it = idList.begin(); it != idList.end(); it++) {
-                    // If not updated (== false)
-                    if(idsControl->value((*it)) == false) {
-                        // Take object
-                        Object *robotObject = _objects.value(VSSRef::Color(i))->value((*it));
+                    // Update it with invalid values
+                    bool wasValid = !robotObject->getPosition().isInvalid();
+                    robotObject->updateObject(0.0f, Position(false, 0.0, 0.0), Angle(false, 0.0));
 
-                        // Update it with invalid values
-                        robotObject->updateObject(0.0f, Position(false, 0.0, 0.0), Angle(false, 0.0));
+                    // Object lost
+                    if(wasValid && robotObject->getPosition().isInvalid() && getMetrics() != nullptr) {
+                        getMetrics()->incrementObjectLoss(VSSRef::Color(i), (*it));
                     }
                 }
             }
+        }
+
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->markFiltered(traceId);
+        }
+
+        // Count frame with its objects (snapshots take both under the same lock)
+        _frameCount.fetch_add(1, std::memory_order_release);
 
-            // Release mutex
-            _dataMutex.unlock();
+        // Release mutex
+        _dataMutex.unlock();
 
-            emit visionUpdated();
+        // Snapshot is now readable by referee
+        if(_latencyTracker != nullptr) {
+            _latencyTracker->markPublished(traceId);
         }
+
+        // Wake idle entities waiting for frames
+        for(int i = 0; i < _frameListeners.size(); i++) {
+            _frameListeners.at(i)->wakeUpOnFrame();
+        }
+
+        emit visionUpdated();
     }
 }
 
 void Vision::finalization() {
+    // Removing socket from reactor
+    if(getNetworkReactor() != nullptr) {
+        getNetworkReactor()->removeSocket(_visionClient);
+    }
+
     // Closing socket
-    if(_visionClient->isOpen()) {
+    if(_visionClient != nullptr && _visionClient->isOpen()) {
         _visionClient->close();
     }
 
     // Deleting vision client
     delete _visionClient;
 
+    // Detaching from ring
+    if(_visionRing.isOpen()) {
+        if(_visionRing.overruns() > 0) {
+            std::cout << Text::blue("[VISION] ", true) + Text::yellow("Skipped " + std::to_string(_visionRing.overruns()) + " ring frames overwritten before read.", true) + '\n';
+        }
+        _visionRing.close();
+    }
+
     std::cout << Text::blue("[VISION] ", true) + Text::bold("Module finished.") + '\n';
 }
 
@@ -154,7 +326,7 @@ void Vision::bindAndConnect() {
 
 void Vision::initObjects() {
     // Init ball object
-    _ballObject = new Object(getConstants()->useKalman());
+    _ballObject = new Object(getConstants()->useKalman(), getConstants()->noiseTime(), getConstants()->lossTime(), getClock());
 
     // Init robot objects
     for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
@@ -162,7 +334,7 @@ void Vision::initObjects() {
         QHash<quint8, Object*> *teamObjects = new QHash<quint8, Object*>();
         _objects.insert(VSSRef::Color(i), teamObjects);
         for(int j = 0; j < getConstants()->qtPlayers(); j++) {
-            teamObjects->insert(j, new Object(getConstants()->useKalman()));
+            teamObjects->insert(j, new Object(getConstants()->useKalman(), getConstants()->noiseTime(), getConstants()->lossTime(), getClock()));
         }
 
         // Init objects control
@@ -220,6 +392,14 @@ void Vision::clearObjectsControl() {
     }
 }
 
+void Vision::setLatencyTracker(LatencyTracker *latencyTracker) {
+    _latencyTracker = latencyTracker;
+}
+
+void Vision::addFrameListener(Entity *entity) {
+    _frameListeners.push_back(entity);
+}
+
 QList<quint8> Vision::getAvailablePlayers(VSSRef::Color teamColor) {
     _dataMutex.lockForRead();
     QList<quint8> availableList;
@@ -283,6 +463,49 @@ Velocity Vision::getBallVelocity() {
     return vel;
 }
 
+quint64 Vision::getFrameCount() {
+    return _frameCount.load(std::memory_order_acquire);
+}
+
+void Vision::takeSnapshot(VisionSnapshot *snapshot) {
+    _dataMutex.lockForRead();
+
+    // Take available players of each team
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        VisionSnapshot::Team &team = snapshot->teams[i];
+        team.playersCount = 0;
+
+        const QHash<quint8, Object*> *objectList = _objects.value(VSSRef::Color(i));
+        for(QHash<quint8, Object*>::const_iterator it = objectList->constBegin(); it != objectList->constEnd() && team.playersCount < VisionSnapshot::MAX_PLAYERS; it++) {
+            Position position = it.value()->getPosition();
+            if(position.isInvalid()) {
+                continue;
+            }
+
+            Velocity velocity = it.value()->getVelocity();
+            VisionSnapshot::Player &player = team.players[team.playersCount++];
+            player.playerId = it.key();
+            player.x = position.x();
+            player.y = position.y();
+            player.vx = velocity.vx();
+            player.vy = velocity.vy();
+            player.orientation = it.value()->getOrientation().value();
+        }
+    }
+
+    // Take ball
+    Position ballPosition = _ballObject->getPosition();
+    Velocity ballVelocity = _ballObject->getVelocity();
+    snapshot->isBallValid = !ballPosition.isInvalid();
+    snapshot->ballX = ballPosition.x();
+    snapshot->ballY = ballPosition.y();
+    snapshot->ballVx = ballVelocity.vx();
+    snapshot->ballVy = ballVelocity.vy();
+    snapshot->frameCount = _frameCount.load(std::memory_order_acquire);
+
+    _dataMutex.unlock();
+}
+
 Constants* Vision::getConstants() {
     if(_constants == nullptr) {
         std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at Vision") + '\n';
@@ -3,20 +3,33 @@
 
 #include <QUdpSocket>
 #include <QNetworkDatagram>
-#include <QReadWriteLock>
 
 #include <src/utils/types/object/object.h>
 #include <include/vssref_common.pb.h>
+#include <include/packet.pb.h>
 #include <src/world/entities/entity.h>
 #include <src/constants/constants.h>
+#include <src/utils/latency/latencytracker.h>
+#include <src/world/entities/vision/visionsnapshot/visionsnapshot.h>
+#include <src/utils/shmring/shmring.h>
+#include <src/world/entities/networkreactor/networkreactor.h>
 
 class Vision : public Entity
 {
     Q_OBJECT
 public:
-    Vision(Constants *constants);
+    Vision(Constants *constants, Clock *clock);
     ~Vision();
 
+    // Frame processing (also fed directly by lockstep)
+    void processEnvironment(const fira_message::sim_to_ref::Environment &environmentData, quint64 traceId = 0);
+
+    // Latency tracing
+    void setLatencyTracker(LatencyTracker *latencyTracker);
+
+    // Entities woken up by new frames while idle (added before start)
+    void addFrameListener(Entity *entity);
+
     // Getters
     QList<quint8> getAvailablePlayers(VSSRef::Color teamColor);
     Position getPlayerPosition(VSSRef::Color teamColor, quint8 playerId);
@@ -25,6 +38,12 @@ public:
     Position getBallPosition();
     Velocity getBallVelocity();
 
+    // Published frames count (changes when a new snapshot is readable)
+    quint64 getFrameCount();
+
+    // Copy of all available objects (one read lock, no allocations)
+    void takeSnapshot(VisionSnapshot *snapshot);
+
 private:
     // Entity inherited methods
     void initialization();
@@ -38,6 +57,13 @@ private:
     // Socket to receive vision data
     QUdpSocket *_visionClient;
     void bindAndConnect();
+    int receiveDatagrams();
+
+    // Shared memory ring to receive vision data (co-located simulator)
+    bool _useSharedMemory;
+    ShmRing _visionRing;
+    fira_message::sim_to_ref::Environment _ringEnvironment;
+    int receiveFromRing();
 
     // Network
     QString _visionAddress;
@@ -52,7 +78,14 @@ private:
     void clearObjectsControl();
 
     // Data management
-    QReadWriteLock _dataMutex;
+    ProfiledReadWriteLock _dataMutex;
+
+    // Latency tracing (nullptr if disabled)
+    LatencyTracker *_latencyTracker;
+
+    // Frame listeners
+    QList<Entity*> _frameListeners;
+    std::atomic<quint64> _frameCount;
 
 signals:
     void visionUpdated();
@@ -0,0 +1,38 @@
+#ifndef VISIONSNAPSHOT_H
+#define VISIONSNAPSHOT_H
+
+#include <QtGlobal>
+
+// Flat copy of the Vision objects, taken in a single read of the vision data
+struct VisionSnapshot {
+    static const int MAX_PLAYERS = 16;
+
+    struct Player {
+        quint8 playerId;
+        float x;
+        float y;
+        float vx;
+        float vy;
+        float orientation;
+    };
+
+    struct Team {
+        int playersCount;
+        Player players[MAX_PLAYERS];
+    };
+
+    // Available players of each team (indexed by color)
+    Team teams[2];
+
+    // Ball
+    bool isBallValid;
+    float ballX;
+    float ballY;
+    float ballVx;
+    float ballVy;
+
+    // Published frame this snapshot was taken from
+    quint64 frameCount;
+};
+
+#endif // VISIONSNAPSHOT_H
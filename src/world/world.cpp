@@ -3,6 +3,9 @@
 World::World(Constants *constants) {
     // Taking constants
     _constants = constants;
+
+    // No entities registered yet
+    _entitiesCount = 0;
 }
 
 void World::addEntity(Entity *entity, int entityPriotity) {
@@ -15,7 +18,10 @@ void World::addEntity(Entity *entity, int entityPriotity) {
     // Take entities registered with 'entityPriority' priority
     QHash<int, Entity*> *prioEntities = _worldEntities.value(entityPriotity);
 
-    // Inser them in hash using their id (unique in the software) as key
+    // Give entity an id (unique in this world)
+    entity->setEntityId(_entitiesCount++);
+
+    // Inser them in hash using their id as key
     prioEntities->insert(entity->entityId(), entity);
 
     // Set entity priority
@@ -40,8 +46,9 @@ void World::startEntities() {
            // Take entity
            Entity *entity = *it;
 
-           // Set frequency
+           // Set frequency and thread scheduling
            entity->setLoopFrequency(getConstants()->threadFrequency());
+           entity->setScheduling(getConstants()->entityScheduling(QString::fromStdString(entity->entityName())));
 
            // Start entity
            entity->start();
@@ -22,6 +22,7 @@ public:
 private:
     // Hashtable for entities
     QMap<int, QHash<int, Entity*>*> _worldEntities;
+    int _entitiesCount;
 
     // Constants
     Constants *_constants;
@@ -0,0 +1,59 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <tools/trafficgen/trafficgen.h>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Parsing command line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("VSSReferee vision traffic generator");
+    parser.addHelpOption();
+    parser.addPositionalArgument("constants", "Constants file of the referee under test.", "[constants]");
+    parser.addOption(QCommandLineOption("rate", "Initial frame rate (Hz).", "hz", "60"));
+    parser.addOption(QCommandLineOption("max-rate", "Maximum frame rate (Hz).", "hz", "4000"));
+    parser.addOption(QCommandLineOption("rate-factor", "Rate multiplier between levels.", "factor", "2.0"));
+    parser.addOption(QCommandLineOption("duration", "Duration of each rate level (s).", "seconds", "20"));
+    parser.addOption(QCommandLineOption("robots", "Robots per team.", "robots", "3"));
+    parser.addOption(QCommandLineOption("burst", "Frames sent back to back in each burst.", "frames", "1"));
+    parser.addOption(QCommandLineOption("reorder", "Probability of out-of-order delivery.", "probability", "0.0"));
+    parser.addOption(QCommandLineOption("drop", "Probability of dropping a frame.", "probability", "0.0"));
+    parser.addOption(QCommandLineOption("max-latency", "Goal to command latency considered lagging (ms).", "ms", "50"));
+    parser.addOption(QCommandLineOption("probe-timeout", "Time to consider a probe missed (s).", "seconds", "2"));
+    parser.addOption(QCommandLineOption("seed", "Random seed for drop and reorder patterns.", "seed", "0"));
+    parser.addOption(QCommandLineOption("csv", "Write levels report as csv to file.", "file"));
+    parser.process(app);
+
+    QString constantsFile = QString(PROJECT_PATH) + "/src/constants/constants.json";
+    if(!parser.positionalArguments().isEmpty()) {
+        constantsFile = parser.positionalArguments().first();
+    }
+
+    // Loading constants of the referee under test
+    Constants *constants = new Constants(constantsFile);
+
+    // Setup generator
+    TrafficGenerator *generator = new TrafficGenerator(constants);
+    generator->setRates(parser.value("rate").toInt(), parser.value("max-rate").toInt(), parser.value("rate-factor").toFloat());
+    generator->setLevelDuration(parser.value("duration").toFloat());
+    generator->setRobotsPerTeam(parser.value("robots").toInt());
+    generator->setBurstSize(parser.value("burst").toInt());
+    generator->setReorderProbability(parser.value("reorder").toFloat());
+    generator->setDropProbability(parser.value("drop").toFloat());
+    generator->setMaxLatency(parser.value("max-latency").toFloat());
+    generator->setProbeTimeout(parser.value("probe-timeout").toFloat());
+    generator->setSeed(parser.value("seed").toUInt());
+    if(parser.isSet("csv")) {
+        generator->setCsvFile(parser.value("csv"));
+    }
+
+    // Run levels
+    generator->run();
+
+    delete generator;
+    delete constants;
+
+    return 0;
+}
@@ -0,0 +1,431 @@
+#include "trafficgen.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <math.h>
+#include <thread>
+#include <algorithm>
+
+#include <src/utils/types/field/field_default_3v3.h>
+
+TrafficGenerator::TrafficGenerator(Constants *constants) {
+    // Taking constants
+    _constants = constants;
+
+    // Default traffic parameters
+    _startRate = 60;
+    _maxRate = 4000;
+    _rateFactor = 2.0f;
+    _levelDuration = 20.0f;
+    _robotsPerTeam = getConstants()->qtPlayers();
+    _burstSize = 1;
+    _reorderProbability = 0.0f;
+    _dropProbability = 0.0f;
+    _maxLatency = 50.0f;
+    _probeTimeout = 2.0f;
+    _random.seed(0);
+
+    // Init vars
+    _step = 0;
+    _hasHeldFrame = false;
+    _probeState = PROBE_WAIT_GAME_ON;
+    _lastFoul = VSSRef::Foul::STOP;
+    _lastCommandTimestamp = -1.0;
+
+    // Connect to network
+    bindAndConnect();
+}
+
+TrafficGenerator::~TrafficGenerator() {
+    disconnectClient();
+}
+
+void TrafficGenerator::setRates(int startRate, int maxRate, float rateFactor) {
+    _startRate = std::max(1, startRate);
+    _maxRate = std::max(_startRate, maxRate);
+    _rateFactor = std::max(1.01f, rateFactor);
+}
+
+void TrafficGenerator::setLevelDuration(float seconds) {
+    _levelDuration = seconds;
+}
+
+void TrafficGenerator::setRobotsPerTeam(int robots) {
+    _robotsPerTeam = robots;
+}
+
+void TrafficGenerator::setBurstSize(int burstSize) {
+    _burstSize = std::max(1, burstSize);
+}
+
+void TrafficGenerator::setReorderProbability(float probability) {
+    _reorderProbability = probability;
+}
+
+void TrafficGenerator::setDropProbability(float probability) {
+    _dropProbability = probability;
+}
+
+void TrafficGenerator::setMaxLatency(float miliSeconds) {
+    _maxLatency = miliSeconds;
+}
+
+void TrafficGenerator::setProbeTimeout(float seconds) {
+    _probeTimeout = seconds;
+}
+
+void TrafficGenerator::setSeed(unsigned int seed) {
+    _random.seed(seed);
+}
+
+void TrafficGenerator::setCsvFile(QString fileName) {
+    _csvFile = fileName;
+}
+
+void TrafficGenerator::bindAndConnect() {
+    // Creating sockets
+    _visionSocket = new QUdpSocket();
+    _refereeSocket = new QUdpSocket();
+    _replacerSocket = new QUdpSocket();
+
+    // Binding referee socket to receive commands
+    if(_refereeSocket->bind(QHostAddress(getConstants()->refereeAddress()), getConstants()->refereePort(), QUdpSocket::ShareAddress) == false) {
+        std::cout << Text::blue("[TRAFFICGEN] ", true) << Text::red("Error while binding referee socket.", true) + '\n';
+    }
+    else if(_refereeSocket->joinMulticastGroup(QHostAddress(getConstants()->refereeAddress())) == false) {
+        std::cout << Text::blue("[TRAFFICGEN] ", true) << Text::red("Error while joining referee multicast.", true) + '\n';
+    }
+
+    // Binding at fira port to receive replacer packets (in place of FIRASim)
+    if(_replacerSocket->bind(QHostAddress::AnyIPv4, getConstants()->firaPort(), QUdpSocket::ShareAddress) == false) {
+        std::cout << Text::blue("[TRAFFICGEN] ", true) << Text::red("Error while binding replacer socket.", true) + '\n';
+    }
+}
+
+void TrafficGenerator::disconnectClient() {
+    // Closing and deleting sockets
+    QUdpSocket *sockets[3] = {_visionSocket, _refereeSocket, _replacerSocket};
+    for(int i = 0; i < 3; i++) {
+        if(sockets[i]->isOpen()) {
+            sockets[i]->close();
+        }
+
+        delete sockets[i];
+    }
+}
+
+void TrafficGenerator::run() {
+    std::cout << Text::blue("[TRAFFICGEN] ", true) + Text::bold("Sending to '" + getConstants()->visionAddress().toStdString() + ":" + std::to_string(getConstants()->visionPort()) + "' with " + std::to_string(_robotsPerTeam) + " robots per team, burst " + std::to_string(_burstSize) + ", reorder " + std::to_string(_reorderProbability) + ", drop " + std::to_string(_dropProbability) + ".") + '\n';
+
+    // Run levels with increasing rate
+    QVector<LevelReport> reports;
+    for(double rate = _startRate; rate <= _maxRate; rate *= _rateFactor) {
+        runLevel(int(rate));
+        reports.push_back(_report);
+
+        std::cout << Text::blue("[TRAFFICGEN] ", true) + Text::bold("Level " + std::to_string(_report.rate) + " Hz: " + std::to_string(_report.probes) + " probes, " + std::to_string(_report.missedProbes) + " missed, p95 latency " + std::to_string(_report.p95Latency) + " ms.") + '\n';
+    }
+
+    printReport(reports);
+
+    if(!_csvFile.isEmpty()) {
+        writeCsv(reports);
+    }
+}
+
+void TrafficGenerator::runLevel(int rate) {
+    // Reset level statistics
+    _report = LevelReport();
+    _report.rate = rate;
+    _latencies.clear();
+    _replacerDelays.clear();
+    _probeState = PROBE_WAIT_GAME_ON;
+
+    // Bursts are sent back to back, keeping the mean rate
+    const std::chrono::nanoseconds interval(static_cast<long long>(1E9 * _burstSize / rate));
+    const auto startTime = std::chrono::steady_clock::now();
+    auto nextSend = startTime;
+
+    Timer levelTimer;
+    levelTimer.start();
+
+    while(true) {
+        levelTimer.stop();
+        const double elapsedTime = levelTimer.getSeconds();
+        if(elapsedTime >= _levelDuration) {
+            break;
+        }
+
+        // Send frames
+        if(std::chrono::steady_clock::now() >= nextSend) {
+            for(int i = 0; i < _burstSize; i++) {
+                sendFrame(elapsedTime);
+            }
+            nextSend += interval;
+        }
+
+        // Read referee and replacer outputs
+        readReferee();
+        readReplacer();
+        updateProbe(elapsedTime);
+
+        // Wait until next send (polling outputs at least each ms)
+        auto wakeup = std::min(nextSend, std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+        std::this_thread::sleep_until(wakeup);
+    }
+
+    // Probe still unanswered after timeout is a miss
+    if(_probeState == PROBE_GOAL) {
+        _probeTimer.stop();
+        if(_probeTimer.getSeconds() >= _probeTimeout) {
+            _report.missedProbes++;
+        }
+    }
+
+    // Finish statistics
+    levelTimer.stop();
+    _report.achievedRate = (_report.framesSent + _report.framesDropped) / levelTimer.getSeconds();
+    finishReport();
+}
+
+void TrafficGenerator::sendFrame(double elapsedTime) {
+    // Build frame
+    fira_message::sim_to_ref::Environment environment;
+    buildEnvironment(&environment, elapsedTime);
+
+    std::string msg;
+    environment.SerializeToString(&msg);
+
+    // Drop pattern
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    if(distribution(_random) < _dropProbability) {
+        _report.framesDropped++;
+        return ;
+    }
+
+    // Out of order delivery (hold frame and send it after the next one)
+    if(!_hasHeldFrame && distribution(_random) < _reorderProbability) {
+        _heldFrame = msg;
+        _hasHeldFrame = true;
+        _report.framesReordered++;
+        return ;
+    }
+
+    _visionSocket->writeDatagram(msg.c_str(), msg.size(), QHostAddress(getConstants()->visionAddress()), getConstants()->visionPort());
+    _report.framesSent++;
+
+    if(_hasHeldFrame) {
+        _visionSocket->writeDatagram(_heldFrame.c_str(), _heldFrame.size(), QHostAddress(getConstants()->visionAddress()), getConstants()->visionPort());
+        _hasHeldFrame = false;
+        _report.framesSent++;
+    }
+}
+
+void TrafficGenerator::buildEnvironment(fira_message::sim_to_ref::Environment *environment, double elapsedTime) {
+    const double halfLength = Field_Default_3v3::kFieldLength / 2000.0;
+
+    environment->set_step(_step++);
+    fira_message::Frame *frame = environment->mutable_frame();
+
+    // Ball (probes move it into the right goal area and then into the goal)
+    fira_message::Ball *ball = frame->mutable_ball();
+    if(_probeState == PROBE_AREA) {
+        ball->set_x(halfLength - 0.07);
+        ball->set_y(0.0);
+    }
+    else if(_probeState == PROBE_GOAL) {
+        ball->set_x(halfLength + 0.05);
+        ball->set_y(0.0);
+    }
+    else {
+        // Keep ball moving around the center, so it is never stucked
+        ball->set_x(0.2 * cos(elapsedTime));
+        ball->set_y(0.2 * sin(elapsedTime));
+    }
+
+    // Robots (far from goal areas, with a small motion)
+    for(int i = VSSRef::Color::BLUE; i <= VSSRef::Color::YELLOW; i++) {
+        double factor = (i == VSSRef::Color::BLUE) ? -1.0 : 1.0;
+        for(int j = 0; j < _robotsPerTeam; j++) {
+            fira_message::Robot *robot = (i == VSSRef::Color::BLUE) ? frame->add_robots_blue() : frame->add_robots_yellow();
+            robot->set_robot_id(j);
+            robot->set_x(factor * (0.1 + 0.1 * (j % 4)));
+            robot->set_y(-0.5 + 0.1 * (j / 4) + 0.02 * sin(elapsedTime + j));
+            robot->set_orientation(0.0);
+        }
+    }
+}
+
+void TrafficGenerator::updateProbe(double elapsedTime) {
+    Q_UNUSED(elapsedTime);
+
+    switch(_probeState) {
+        case PROBE_WAIT_GAME_ON: {
+            // Probe only starts when checkers are running
+            if(_lastFoul == VSSRef::Foul::GAME_ON) {
+                _probeState = PROBE_AREA;
+                _probeTimer.start();
+            }
+        }
+        break;
+        case PROBE_AREA: {
+            // Keep ball in goal area for some referee ticks (play starts)
+            _probeTimer.stop();
+            if(_probeTimer.getSeconds() >= 0.2) {
+                _probeState = PROBE_GOAL;
+                _probeTimer.start();
+                _report.probes++;
+            }
+        }
+        break;
+        case PROBE_GOAL: {
+            // Goal not answered
+            _probeTimer.stop();
+            if(_probeTimer.getSeconds() >= _probeTimeout) {
+                _report.missedProbes++;
+                _probeState = PROBE_WAIT_GAME_ON;
+            }
+        }
+        break;
+        case PROBE_WAIT_REPLACER: {
+            // Replacement not sent
+            _replacerTimer.stop();
+            if(_replacerTimer.getSeconds() >= getConstants()->transitionTime() + _probeTimeout) {
+                _probeState = PROBE_WAIT_GAME_ON;
+            }
+        }
+        break;
+    }
+}
+
+void TrafficGenerator::readReferee() {
+    while(_refereeSocket->hasPendingDatagrams()) {
+        VSSRef::ref_to_team::VSSRef_Command command;
+        QNetworkDatagram datagram = _refereeSocket->receiveDatagram();
+        if(!datagram.isValid() || !command.ParseFromArray(datagram.data().data(), datagram.data().size())) {
+            continue;
+        }
+
+        // Heartbeats repeat the last command (same game timestamp)
+        if(command.foul() == _lastFoul && command.timestamp() == _lastCommandTimestamp) {
+            continue;
+        }
+        _lastCommandTimestamp = command.timestamp();
+
+        _report.commandsReceived++;
+        _lastFoul = command.foul();
+
+        // Correlate with the probe goal
+        if(_probeState == PROBE_GOAL) {
+            _probeTimer.stop();
+            if(command.foul() == VSSRef::Foul::KICKOFF) {
+                _latencies.push_back(_probeTimer.getMiliSeconds());
+                _probeState = PROBE_WAIT_REPLACER;
+                _replacerTimer.start();
+            }
+            else {
+                // Other foul answered the probe, so it is not valid
+                _report.missedProbes++;
+                _probeState = PROBE_WAIT_GAME_ON;
+            }
+        }
+    }
+}
+
+void TrafficGenerator::readReplacer() {
+    while(_replacerSocket->hasPendingDatagrams()) {
+        fira_message::sim_to_ref::Packet packet;
+        QNetworkDatagram datagram = _replacerSocket->receiveDatagram();
+        if(!datagram.isValid() || !packet.ParseFromArray(datagram.data().data(), datagram.data().size())) {
+            continue;
+        }
+
+        _report.replacerPackets++;
+
+        // Correlate with the kickoff placement
+        if(_probeState == PROBE_WAIT_REPLACER && packet.has_replace() && packet.replace().robots_size() > 0) {
+            _replacerTimer.stop();
+            _replacerDelays.push_back(_replacerTimer.getMiliSeconds());
+            _probeState = PROBE_WAIT_GAME_ON;
+        }
+    }
+}
+
+void TrafficGenerator::finishReport() {
+    // Latency statistics
+    std::sort(_latencies.begin(), _latencies.end());
+    if(!_latencies.isEmpty()) {
+        double sum = 0.0;
+        for(int i = 0; i < _latencies.size(); i++) {
+            sum += _latencies.at(i);
+        }
+        _report.meanLatency = sum / _latencies.size();
+        _report.p95Latency = _latencies.at(std::min(_latencies.size() - 1, int(ceil(0.95 * _latencies.size())) - 1));
+        _report.maxLatency = _latencies.last();
+    }
+
+    // Replacer statistics
+    if(!_replacerDelays.isEmpty()) {
+        double sum = 0.0;
+        for(int i = 0; i < _replacerDelays.size(); i++) {
+            sum += _replacerDelays.at(i);
+        }
+        _report.meanReplacerDelay = sum / _replacerDelays.size();
+    }
+
+    // Lagging when probes are missed or answered too late
+    _report.isLagging = (_report.missedProbes > 0) || (!_latencies.isEmpty() && _report.p95Latency > _maxLatency);
+}
+
+void TrafficGenerator::printReport(const QVector<LevelReport> &reports) {
+    std::cout << Text::blue("[TRAFFICGEN] ", true) + Text::bold("rate | achieved | sent | dropped | reordered | probes | missed | mean ms | p95 ms | max ms | replacer ms | commands | replacer pkts") + '\n';
+
+    int capacity = 0;
+    bool foundLag = false;
+    for(int i = 0; i < reports.size(); i++) {
+        const LevelReport &report = reports.at(i);
+        std::string line = std::to_string(report.rate) + " | " + std::to_string(report.achievedRate) + " | " + std::to_string(report.framesSent) + " | " + std::to_string(report.framesDropped) + " | " + std::to_string(report.framesReordered) + " | " + std::to_string(report.probes) + " | " + std::to_string(report.missedProbes) + " | " + std::to_string(report.meanLatency) + " | " + std::to_string(report.p95Latency) + " | " + std::to_string(report.maxLatency) + " | " + std::to_string(report.meanReplacerDelay) + " | " + std::to_string(report.commandsReceived) + " | " + std::to_string(report.replacerPackets);
+        std::cout << Text::blue("[TRAFFICGEN] ", true) + (report.isLagging ? Text::red(line, true) : Text::green(line, true)) + '\n';
+
+        // Capacity is the highest rate before the first lagging level
+        if(!foundLag) {
+            if(report.isLagging) {
+                foundLag = true;
+            }
+            else if(report.probes > 0) {
+                capacity = report.rate;
+            }
+        }
+    }
+
+    std::cout << Text::blue("[TRAFFICGEN] ", true) + Text::bold("Vision capacity: " + (capacity > 0 ? std::to_string(capacity) + " Hz" : std::string("unknown (no answered probes)")) + (foundLag ? "" : " (no lag found until max rate)")) + '\n';
+}
+
+void TrafficGenerator::writeCsv(const QVector<LevelReport> &reports) {
+    QFile file(_csvFile);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::cout << Text::blue("[TRAFFICGEN] ", true) << Text::red("Error while opening '" + _csvFile.toStdString() + "'.", true) + '\n';
+        return ;
+    }
+
+    QTextStream stream(&file);
+    stream << "rate,achieved_rate,frames_sent,frames_dropped,frames_reordered,probes,missed_probes,mean_latency_ms,p95_latency_ms,max_latency_ms,mean_replacer_delay_ms,commands,replacer_packets,lagging\n";
+    for(int i = 0; i < reports.size(); i++) {
+        const LevelReport &report = reports.at(i);
+        stream << report.rate << ',' << report.achievedRate << ',' << report.framesSent << ',' << report.framesDropped << ',' << report.framesReordered << ',' << report.probes << ',' << report.missedProbes << ',' << report.meanLatency << ',' << report.p95Latency << ',' << report.maxLatency << ',' << report.meanReplacerDelay << ',' << report.commandsReceived << ',' << report.replacerPackets << ',' << (report.isLagging ? 1 : 0) << '\n';
+    }
+
+    file.close();
+}
+
+Constants* TrafficGenerator::getConstants() {
+    if(_constants == nullptr) {
+        std::cout << Text::red("[ERROR] ", true) << Text::bold("Constants with nullptr value at TrafficGenerator") + '\n';
+    }
+    else {
+        return _constants;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,111 @@
+#ifndef TRAFFICGEN_H
+#define TRAFFICGEN_H
+
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+#include <QVector>
+
+#include <random>
+
+#include <src/constants/constants.h>
+#include <src/utils/timer/timer.h>
+#include <include/packet.pb.h>
+#include <include/vssref_command.pb.h>
+
+class TrafficGenerator
+{
+public:
+    TrafficGenerator(Constants *constants);
+    ~TrafficGenerator();
+
+    // Setters
+    void setRates(int startRate, int maxRate, float rateFactor);
+    void setLevelDuration(float seconds);
+    void setRobotsPerTeam(int robots);
+    void setBurstSize(int burstSize);
+    void setReorderProbability(float probability);
+    void setDropProbability(float probability);
+    void setMaxLatency(float miliSeconds);
+    void setProbeTimeout(float seconds);
+    void setSeed(unsigned int seed);
+    void setCsvFile(QString fileName);
+
+    // Run all rate levels and report
+    void run();
+
+private:
+    // Constants
+    Constants *_constants;
+    Constants* getConstants();
+
+    // Network
+    QUdpSocket *_visionSocket;
+    QUdpSocket *_refereeSocket;
+    QUdpSocket *_replacerSocket;
+    void bindAndConnect();
+    void disconnectClient();
+
+    // Traffic parameters
+    int _startRate;
+    int _maxRate;
+    float _rateFactor;
+    float _levelDuration;
+    int _robotsPerTeam;
+    int _burstSize;
+    float _reorderProbability;
+    float _dropProbability;
+    float _maxLatency;
+    float _probeTimeout;
+    QString _csvFile;
+    std::mt19937 _random;
+
+    // Frame generation
+    quint32 _step;
+    std::string _heldFrame;
+    bool _hasHeldFrame;
+    void sendFrame(double elapsedTime);
+    void buildEnvironment(fira_message::sim_to_ref::Environment *environment, double elapsedTime);
+
+    // Probe (ball sent into a goal, answered by a referee command)
+    enum ProbeState {
+        PROBE_WAIT_GAME_ON,
+        PROBE_AREA,
+        PROBE_GOAL,
+        PROBE_WAIT_REPLACER
+    };
+    ProbeState _probeState;
+    Timer _probeTimer;
+    Timer _replacerTimer;
+    VSSRef::Foul _lastFoul;
+    double _lastCommandTimestamp;
+    void updateProbe(double elapsedTime);
+
+    // Level statistics
+    struct LevelReport {
+        int rate;
+        double achievedRate;
+        quint64 framesSent;
+        quint64 framesDropped;
+        quint64 framesReordered;
+        int probes;
+        int missedProbes;
+        double meanLatency;
+        double p95Latency;
+        double maxLatency;
+        double meanReplacerDelay;
+        quint64 commandsReceived;
+        quint64 replacerPackets;
+        bool isLagging;
+    };
+    LevelReport _report;
+    QVector<double> _latencies;
+    QVector<double> _replacerDelays;
+    void runLevel(int rate);
+    void readReferee();
+    void readReplacer();
+    void finishReport();
+    void printReport(const QVector<LevelReport> &reports);
+    void writeCsv(const QVector<LevelReport> &reports);
+};
+
+#endif // TRAFFICGEN_H
@@ -0,0 +1,53 @@
+# Qt libs to import
+QT += core    \
+      network
+
+# Referee sources are included from the repository root
+ROOT_PATH = $${PWD}/../..
+INCLUDEPATH += $${ROOT_PATH}
+
+# Project configs
+TEMPLATE = app
+DESTDIR  = $${ROOT_PATH}/bin
+TARGET   = VSSTrafficGen
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+# Temporary dirs
+OBJECTS_DIR = tmp/obj
+MOC_DIR = tmp/moc
+
+# Project libs
+LIBS *= -lprotobuf -lQt5Core
+
+# Compiling .proto files
+system(echo "Compiling protobuf files" && cd $${ROOT_PATH}/include/proto && protoc --cpp_out=../ *.proto)
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += PROJECT_PATH=\\\"$${ROOT_PATH}\\\"
+
+SOURCES += \
+        $${ROOT_PATH}/include/command.pb.cc \
+        $${ROOT_PATH}/include/common.pb.cc \
+        $${ROOT_PATH}/include/packet.pb.cc \
+        $${ROOT_PATH}/include/replacement.pb.cc \
+        $${ROOT_PATH}/include/vssref_command.pb.cc \
+        $${ROOT_PATH}/include/vssref_common.pb.cc \
+        $${ROOT_PATH}/src/constants/constants.cpp \
+        $${ROOT_PATH}/src/utils/clock/clock.cpp \
+        $${ROOT_PATH}/src/utils/logger/logger.cpp \
+        $${ROOT_PATH}/src/utils/scheduling/scheduling.cpp \
+        $${ROOT_PATH}/src/utils/text/text.cpp \
+        $${ROOT_PATH}/src/utils/timer/timer.cpp \
+        main.cpp \
+        trafficgen.cpp
+
+HEADERS += \
+        $${ROOT_PATH}/src/constants/constants.h \
+        $${ROOT_PATH}/src/utils/clock/clock.h \
+        $${ROOT_PATH}/src/utils/logger/logger.h \
+        $${ROOT_PATH}/src/utils/scheduling/scheduling.h \
+        $${ROOT_PATH}/src/utils/text/text.h \
+        $${ROOT_PATH}/src/utils/timer/timer.h \
+        trafficgen.h